@@ -1,20 +1,50 @@
 #pragma once
 
+#include <cppmariadb/aggregate_result.h>
+#include <cppmariadb/balancer.h>
+#include <cppmariadb/breaker.h>
 #include <cppmariadb/column.h>
+#include <cppmariadb/column_cache.h>
 #include <cppmariadb/connection.h>
 #include <cppmariadb/database.h>
+#include <cppmariadb/datetime.h>
+#include <cppmariadb/decimal.h>
 #include <cppmariadb/enums.h>
 #include <cppmariadb/exception.h>
+#include <cppmariadb/executor.h>
 #include <cppmariadb/field.h>
+#include <cppmariadb/hedge.h>
+#include <cppmariadb/limiter.h>
+#include <cppmariadb/merge_result.h>
+#include <cppmariadb/pool.h>
 #include <cppmariadb/result.h>
+#include <cppmariadb/router.h>
+#include <cppmariadb/scheduler.h>
+#include <cppmariadb/shard_router.h>
 #include <cppmariadb/row.h>
+#include <cppmariadb/row_batch.h>
 #include <cppmariadb/statement.h>
 #include <cppmariadb/transaction.h>
 
+#include <cppmariadb/inline/aggregate_result.inl>
+#include <cppmariadb/inline/balancer.inl>
+#include <cppmariadb/inline/breaker.inl>
+#include <cppmariadb/inline/column_cache.inl>
 #include <cppmariadb/inline/connection.inl>
 #include <cppmariadb/inline/database.inl>
+#include <cppmariadb/inline/datetime.inl>
+#include <cppmariadb/inline/decimal.inl>
+#include <cppmariadb/inline/executor.inl>
 #include <cppmariadb/inline/field.inl>
+#include <cppmariadb/inline/hedge.inl>
+#include <cppmariadb/inline/limiter.inl>
+#include <cppmariadb/inline/merge_result.inl>
+#include <cppmariadb/inline/pool.inl>
 #include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/router.inl>
+#include <cppmariadb/inline/scheduler.inl>
+#include <cppmariadb/inline/shard_router.inl>
 #include <cppmariadb/inline/row.inl>
+#include <cppmariadb/inline/row_batch.inl>
 #include <cppmariadb/inline/statement.inl>
 #include <cppmariadb/inline/transaction.inl>
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cppmariadb/config.h>
+#include <cppmariadb/decimal.h>
+#include <cppmariadb/forward/row.h>
+#include <cppmariadb/forward/aggregate_result.h>
+
+namespace cppmariadb
+{
+
+    enum class aggregate_function
+    {
+        Count,                                      /* sum of the partial counts */
+        Sum,                                        /* sum of the partial sums (exact unless the column is FLOAT or DOUBLE) */
+        Min,                                        /* minimum of the partial minimums (compared by the column type) */
+        Max,                                        /* maximum of the partial maximums (compared by the column type) */
+        Avg,                                        /* sum of the partial sums (index) divided by the sum of the partial counts (count_index) */
+    };
+
+    struct aggregate_column
+    {
+        aggregate_function  function;
+        size_t              index;
+        size_t              count_index { 0 };
+    };
+
+    struct aggregate_value
+    {
+        aggregate_function  function;
+        bool                is_null  { true };
+        bool                is_exact { false };     // the sum is kept in exact
+        long long           count    { 0 };
+        double              value    { 0.0 };       // sum of FLOAT and DOUBLE columns
+        decimal             exact    { };           // sum of integer and DECIMAL columns
+        std::string         text     { };           // original data of the minimum or maximum
+
+        inline double result() const;
+    };
+
+    /* Merges partial aggregates of several results in a hash table keyed by the group columns. */
+    struct aggregate_result
+    {
+    public:
+        struct group
+        {
+            std::vector<std::string>        keys;
+            std::vector<bool>               nulls;
+            std::vector<aggregate_value>    values;
+        };
+
+        using group_map = std::unordered_map<std::string, group>;
+
+    private:
+        std::vector<size_t>             _group_columns;
+        std::vector<aggregate_column>   _aggregates;
+        group_map                       _groups;
+        std::string                     _key;
+
+    public:
+               void                 merge   (const row& r);
+        inline const group_map&     groups  () const;
+        inline size_t               size    () const;
+
+        inline aggregate_result(std::vector<size_t> group_columns, std::vector<aggregate_column> aggregates);
+    };
+
+}
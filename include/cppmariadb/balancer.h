@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/balancer.h>
+
+namespace cppmariadb
+{
+
+    /* Selects a replica by the power of two choices: two random replicas are compared
+     * by their latency (EWMA of the query round trip times) weighted by the
+     * number of connections currently in flight. Replicas whose replication lag exceeds
+     * max_lag are ejected by probe() until their lag dropped below restore_lag. */
+    struct balancer
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+        using seconds    = std::chrono::seconds;
+
+        static constexpr long long lag_unknown = -1;
+        static constexpr size_t    npos        = static_cast<size_t>(-1);
+
+    private:
+        struct backend
+        {
+            ::cppmariadb::pool&         replica;
+            std::atomic<double>         latency;    // EWMA in microseconds
+            std::atomic<size_t>         inflight;
+            std::atomic<long long>      lag;        // seconds behind master
+            std::atomic<bool>           ejected;
+
+            inline backend(::cppmariadb::pool& p);
+        };
+
+        using backend_ptru_type = std::unique_ptr<backend>;
+
+        std::vector<backend_ptru_type>  _backends;
+        double                          _decay;
+        seconds                         _max_lag;
+        seconds                         _restore_lag;
+
+        inline double   score   (const backend& b) const;
+               void     record  (backend& b, clock_type::duration d);
+
+    public:
+        inline connection_ptr   acquire     ();
+
+        /* selects any replica except the one at index exclude and stores the index of the
+         * selected replica in index, returns an empty pointer if there is no other replica */
+               connection_ptr   acquire     (size_t exclude, size_t* index);
+               void             probe       ();
+        inline size_t           size        () const;
+        inline pool&            replica     (size_t i) const;
+        inline double           latency     (size_t i) const;
+        inline size_t           inflight    (size_t i) const;
+        inline long long        lag         (size_t i) const;
+        inline bool             ejected     (size_t i) const;
+        inline void             decay       (double value);
+        inline void             max_lag     (seconds value);
+        inline void             restore_lag (seconds value);
+
+        inline balancer(const std::vector<pool*>& replicas);
+
+    private:
+        balancer(const balancer&) = delete;
+    };
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cppmariadb/config.h>
+#include <cppmariadb/enums.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/breaker.h>
+
+namespace cppmariadb
+{
+
+    /* Limits the retries of all backends sharing the budget to a fraction of their requests,
+     * so retries can not amplify an outage. Each request earns ratio tokens, each retry costs
+     * one token. */
+    struct retry_budget
+    {
+    private:
+        double              _ratio;
+        double              _max;
+        double              _tokens;
+        mutable std::mutex  _mutex;
+
+    public:
+        inline void     deposit ();
+        inline bool     withdraw();
+        inline double   tokens  () const;
+
+        inline retry_budget(double ratio = 0.1, double max = 10.0);
+    };
+
+    /* Circuit breaker around the connection pool of a backend. The errors of the executed
+     * requests are counted per error_class in a sliding time window. If the rate of one class
+     * exceeds its threshold the breaker opens and rejects all requests by throwing a
+     * circuit_open_exception. After the cooldown the next request executes the probe query,
+     * which closes the breaker again on success. */
+    struct breaker
+    {
+    public:
+        using clock_type    = std::chrono::steady_clock;
+        using duration      = std::chrono::milliseconds;
+        using state_t       = ::cppmariadb::breaker_state;
+        using error_class_t = ::cppmariadb::error_class;
+
+    private:
+        struct bucket
+        {
+            clock_type::time_point  start;
+            size_t                  total       { 0 };
+            size_t                  connection  { 0 };
+            size_t                  query       { 0 };
+        };
+
+        ::cppmariadb::pool&     _pool;
+        retry_budget*           _budget;
+        std::string             _probe;
+        state_t                 _state;
+        clock_type::time_point  _opened;
+        std::vector<bucket>     _buckets;
+        duration                _bucket_width;
+        duration                _cooldown;
+        size_t                  _min_requests;
+        double                  _connection_threshold;
+        double                  _query_threshold;
+        mutable std::mutex      _mutex;
+
+               void admit   ();
+               void record  (error_class_t c);
+        inline bool retry   (error_class_t c, bool idempotent);
+
+    public:
+        /* executes f(connection&) on a connection of the pool and records the outcome.
+         * Failures to establish a connection are retried within the retry budget, failures
+         * of f only if it is idempotent. */
+        template<class F>
+        inline auto             execute                 (F&& f, bool idempotent = false)
+            -> decltype(f(std::declval<connection&>()));
+
+        inline state_t          state                   () const;
+        inline void             probe                   (const std::string& value);
+        inline void             cooldown                (duration value);
+        inline void             min_requests            (size_t value);
+        inline void             connection_threshold    (double value);
+        inline void             query_threshold         (double value);
+
+        inline breaker(::cppmariadb::pool& p, retry_budget* budget = nullptr, size_t buckets = 10, duration bucket_width = duration(1000));
+
+    private:
+        breaker(const breaker&) = delete;
+    };
+
+}
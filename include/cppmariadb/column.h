@@ -1,7 +1,7 @@
 #pragma once
 
-#include <string>
 #include <vector>
+#include <string_view>
 #include <cppmariadb/config.h>
 #include <cppmariadb/enums.h>
 #include <cppmariadb/forward/column.h>
@@ -9,21 +9,23 @@
 namespace cppmariadb
 {
 
+    /* the names reference the memory of the MYSQL_FIELD the column was created from (or
+     * the interned copy of a column_cache) */
     struct column
     {
-        std::string     name;
-        std::string     original_name;
-        std::string     table;
-        std::string     original_table;
-        std::string     database;
-        unsigned long   length;
-        unsigned long   max_length;
-        column_flags    flags;
-        unsigned int    decimals;
-        unsigned int    charset_number;
-        column_type     type;
+        std::string_view    name;
+        std::string_view    original_name;
+        std::string_view    table;
+        std::string_view    original_table;
+        std::string_view    database;
+        unsigned long       length;
+        unsigned long       max_length;
+        column_flags        flags;
+        unsigned int        decimals;
+        unsigned int        charset_number;
+        column_type         type;
 
-        inline column(MYSQL_FIELD& f)
+        inline column(const MYSQL_FIELD& f)
             : name          (f.name,        f.name_length)
             , original_name (f.org_name,    f.org_name_length)
             , table         (f.table,       f.table_length)
@@ -38,4 +40,11 @@ namespace cppmariadb
             { }
     };
 
+    /* index of a column resolved once by result::column(name), valid for all rows of the
+     * result (and of all results with the same columns) */
+    struct column_handle
+    {
+        size_t index;
+    };
+
 }
\ No newline at end of file
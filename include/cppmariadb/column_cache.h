@@ -0,0 +1,56 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/column.h>
+#include <cppmariadb/forward/column_cache.h>
+
+namespace cppmariadb
+{
+
+    /* Thread safe cache of column metadata keyed by query. The first result of a query interns
+     * its metadata into one immutable column_vector that is shared by all later results of the
+     * same query as long as the result set keeps its shape. The max_length of cached columns is
+     * always zero, it depends on the rows of each single result. If the cache is full the least
+     * recently used query is evicted. */
+    struct column_cache
+    {
+    public:
+        using columns_ptr_type = std::shared_ptr<const column_vector>;
+
+    private:
+        using lru_type = std::list<std::string>;
+
+        struct entry
+        {
+            columns_ptr_type    columns;
+            lru_type::iterator  position;
+        };
+
+        using map_type = std::unordered_map<std::string, entry>;
+
+        size_t              _capacity;
+        map_type            _entries;
+        lru_type            _lru;               // most recently used query first
+        mutable std::mutex  _mutex;
+
+        static columns_ptr_type intern  (const MYSQL_FIELD* fields, size_t count);
+        static bool             matches (const column_vector& columns, const MYSQL_FIELD* fields, size_t count);
+
+    public:
+               columns_ptr_type lookup  (const std::string& query, MYSQL_RES* res);
+        inline size_t           size    () const;
+        inline size_t           capacity() const;
+        inline void             clear   ();
+
+        inline column_cache(size_t capacity = 1024);
+
+    private:
+        column_cache(const column_cache&) = delete;
+    };
+
+}
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <map>
+#include <chrono>
 #include <memory>
+#include <functional>
+#include <vector>
 #include <cppmariadb/config.h>
+#include <cppmariadb/database.h>
+#include <cppmariadb/impl/watchdog.h>
 #include <cppmariadb/impl/mariadb_handle.h>
 #include <cppmariadb/forward/connection.h>
+#include <cppmariadb/forward/column_cache.h>
 #include <cppmariadb/forward/result.h>
 #include <cppmariadb/forward/statement.h>
+#include <cppmariadb/forward/transaction.h>
 
 namespace cppmariadb
 {
@@ -13,13 +21,49 @@ namespace cppmariadb
     struct connection
         : public __impl::mariadb_handle<MYSQL*>
     {
+    public:
+        using clock_type        = std::chrono::steady_clock;
+        using time_point        = clock_type::time_point;
+        using server_timeout_t  = ::cppmariadb::server_timeout;
+        using observer_type     = std::function<void(clock_type::duration)>;
+
+    private:
+        friend struct ::cppmariadb::transaction;
+
+        using result_t          = ::cppmariadb::result;
+        using column_cache_t    = ::cppmariadb::column_cache;
+        using options_ptru_type = std::unique_ptr<connect_options>;
+        using guard_ptru_type   = __impl::watchdog::guard_ptru_type;
+
+    public:
+        using session_state_type  = std::map<std::string, std::string>;
+        using session_values_type = std::vector<std::pair<std::string, std::string>>;
+
     private:
-        using result_t = ::cppmariadb::result;
 
         std::unique_ptr<result_t>   _result;
+        options_ptru_type           _options;           // parameters used to (re)establish the connection
+        bool                        _auto_reconnect;    // reconnect if the connection to the server was lost
+        bool                        _transaction;       // a transaction is currently active on this connection
+        std::vector<std::string>    _session;           // session statements replayed after a reconnect
+        session_state_type          _state;             // known values of session variables ("names" and "schema" included)
+        time_point                  _deadline;          // queries still running at this point in time are killed
+        server_timeout_t            _server_timeout;    // how the remaining time is passed to the server
+        column_cache_t*             _metadata_cache;    // shares the column metadata of repeated queries
+        observer_type               _observer;          // receives the round trip time of every query
+
+        template<class T>
+        typename T::result_type*    execute_internal(const std::string& cmd, const std::string* key = nullptr);
 
         template<class T>
-        typename T::result_type*    execute_internal(const std::string& cmd);
+        inline bool                 try_execute     (const std::string& cmd, MYSQL_RES*& res);
+
+               void                 record_session  (const std::string& cmd);
+               void                 track_session   (const std::string& cmd);
+               void                 execute_batch   (const std::vector<std::string>& cmds);
+               void                 reset_state     ();
+               std::string          apply_deadline  (const std::string& cmd) const;
+        inline guard_ptru_type      watch_deadline  () const;
 
     public:
         inline void                 execute         (const std::string& cmd);
@@ -37,14 +81,58 @@ namespace cppmariadb
         inline result_t*            result          () const;
         inline uint                 fieldcount      () const;
         inline std::string          escape          (const std::string& value) const;
+        inline unsigned long        thread_id       () const;
+        inline bool                 ping            () const;
+               bool                 cancel          () const;
+        inline void                 free_result     ();
         inline void                 close           ();
 
+        inline const connect_options*           options         () const;
+        inline bool                             auto_reconnect  () const;
+        inline void                             auto_reconnect  (bool value);
+        inline const std::vector<std::string>&  session         () const;
+        inline const session_state_type&        session_state   () const;
+
+        /* a transaction is open (started by transaction, START TRANSACTION, BEGIN or XA START, or
+         * autocommit is disabled), queries that fail because the connection was lost are not retried */
+               bool                             in_transaction  () const;
+
+        /* sets the passed session variables (values as SQL literals, "names" for the character set
+         * and "schema" for the default database) that differ from the known session state, all
+         * variables are batched into one SET statement. The schema can only be changed by USE, which
+         * is sent together with the SET statement if the connection allows multi statements and
+         * needs a round trip of its own otherwise */
+               void                             ensure_session  (const session_values_type& values);
+               void                             reconnect       ();
+
+        /* discards the pending result and resets the session on the server (rolls back the open
+         * transaction, drops temporary tables, user variables and session variables) */
+               void                             reset           ();
+               void                             change_user     (const std::string& user,
+                                                                 const std::string& password,
+                                                                 const std::string& database);
+        inline time_point                       deadline        () const;
+        inline void                             deadline        (time_point value);
+        inline server_timeout_t                 server_timeout  () const;
+        inline void                             server_timeout  (server_timeout_t value);
+
+        /* called with the round trip time of every query sent to the server (successful or not),
+         * used to measure the latency of a backend independent of how long a connection is held */
+        inline const observer_type&             observer        () const;
+        inline void                             observer        (observer_type value);
+
+        /* the cache must outlive the connection and all results it returned, results of statements
+         * are cached by the statement template, so all parameter values share one entry */
+        inline column_cache_t*                  metadata_cache  () const;
+        inline void                             metadata_cache  (column_cache_t* value);
+
         inline connection& operator =(connection&& other);
 
         inline connection();
         inline connection(MYSQL* h);
+        inline connection(MYSQL* h, const connect_options& options);
         inline connection(connection&& other);
         inline ~connection();
     };
 
-}
\ No newline at end of file
+}
@@ -1,25 +1,54 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <cppmariadb/config.h>
 #include <cppmariadb/enums.h>
 #include <cppmariadb/forward/connection.h>
+#include <cppmariadb/forward/database.h>
 
 namespace cppmariadb
 {
 
+    struct connect_options
+    {
+        std::string     host;
+        uint            port;
+        std::string     user;
+        std::string     password;
+        std::string     database;
+        client_flags    flags;
+    };
+
     struct database
     {
-        using error_code_t = ::cppmariadb::error_code;
+        using error_code_t  = ::cppmariadb::error_code;
+        using query_type_t  = ::cppmariadb::query_type;
+        using error_class_t = ::cppmariadb::error_class;
+
+        static inline connection    connect         (const std::string&     host,
+                                                     const uint&            port,
+                                                     const std::string&     user,
+                                                     const std::string&     password,
+                                                     const std::string&     database,
+                                                     const client_flags&    flags);
+        /* a timeout (zero for the defaults of the client library) limits connecting as well as
+         * each single read and write on the connection */
+        static inline connection    connect         (const connect_options& options,
+                                                     std::chrono::seconds   timeout = std::chrono::seconds::zero());
+        static inline error_code_t  error_code      (MYSQL* handle);
+        static inline std::string   error_msg       (MYSQL* handle);
+        static inline bool          connection_lost (error_code_t err);
+        static inline error_class_t error_class     (error_code_t err);
+        static        query_type_t  query_type      (const std::string& cmd);
+        static        void          kill_query      (const connect_options& options,
+                                                     unsigned long          thread_id,
+                                                     std::chrono::seconds   timeout = std::chrono::seconds(5));
 
-        static inline connection    connect    (const std::string&     host,
-                                                const uint&            port,
-                                                const std::string&     user,
-                                                const std::string&     password,
-                                                const std::string&     database,
-                                                const client_flags&    flags);
-        static inline error_code_t  error_code (MYSQL* handle);
-        static inline std::string   error_msg  (MYSQL* handle);
+        /* initializes the client library (once) and the calling thread (once per thread, the
+         * thread is cleaned up automatically when it exits), called implicitly by connect and
+         * by every query */
+        static        void          thread_init     ();
     };
 
-}
\ No newline at end of file
+}
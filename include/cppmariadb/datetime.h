@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/datetime.h>
+
+namespace cppmariadb
+{
+
+    /* DATE, DATETIME or TIMESTAMP value as sent by the server (time of day is zero for DATE) */
+    struct datetime
+    {
+        int         year        { 0 };
+        unsigned    month       { 0 };
+        unsigned    day         { 0 };
+        unsigned    hour        { 0 };
+        unsigned    minute      { 0 };
+        unsigned    second      { 0 };
+        unsigned    microsecond { 0 };
+
+        /* interprets the value as UTC, zero dates (e.g. 0000-00-00) and fields out of range can not be converted */
+        inline std::chrono::system_clock::time_point to_time_point() const;
+    };
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/decimal.h>
+
+namespace cppmariadb
+{
+
+    /* exact fixed point number with the value unscaled / 10^scale, backed by a 128 bit integer
+     * (38 digits) where the compiler supports it and by a 64 bit integer (18 digits) otherwise */
+    struct decimal
+    {
+    public:
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef          __int128 value_type;
+        __extension__ typedef unsigned __int128 uvalue_type;
+        static constexpr unsigned max_digits = 38;
+#else
+        using value_type  = long long;
+        using uvalue_type = unsigned long long;
+        static constexpr unsigned max_digits = 18;
+#endif
+
+        /* scale passed to parse() to take the number of fraction digits of the text */
+        static constexpr unsigned auto_scale = std::numeric_limits<unsigned>::max();
+
+        value_type  unscaled { 0 };
+        unsigned    scale    { 0 };
+
+        inline std::string  to_string   () const;
+        inline double       to_double   () const;
+        inline bool         operator == (const decimal& other) const;
+        inline bool         operator != (const decimal& other) const;
+
+        /* exact comparison of values with different scales, returns <0, 0 or >0 */
+        static inline int compare(decimal a, decimal b);
+
+        /* parses [+-]digits[.digits] without any allocation, fraction digits are padded to the
+         * scale; fails for invalid text, more fraction digits than scale and more than
+         * max_digits significant digits */
+        static inline bool parse(const char* c, size_t s, unsigned scale, decimal& ret);
+    };
+
+}
@@ -94,6 +94,36 @@ namespace cppmariadb
     };
     using client_flags  = utl::simple_flags<client_flag>;
 
+    enum class query_type
+    {
+        Unknown,                                    /* empty or unparsable query */
+        Read,                                       /* SELECT, SHOW, DESCRIBE, EXPLAIN, ... */
+        Write,                                      /* everything that may modify data */
+        Session,                                    /* SET, USE */
+        Transaction,                                /* START TRANSACTION, BEGIN, COMMIT, ROLLBACK, ... */
+    };
+
+    enum class server_timeout
+    {
+        None,                                       /* deadlines are only enforced by KILL QUERY */
+        MaxStatementTime,                           /* MariaDB: SET STATEMENT max_statement_time=... FOR ... */
+        MaxExecutionTime,                           /* MySQL: MAX_EXECUTION_TIME optimizer hint (SELECT only) */
+    };
+
+    enum class error_class
+    {
+        None,                                       /* no error */
+        Connection,                                 /* the server could not be reached or the connection was lost */
+        Query,                                      /* the server rejected or failed to execute the query */
+    };
+
+    enum class breaker_state
+    {
+        Closed,                                     /* requests pass */
+        Open,                                       /* requests are rejected until the cooldown elapsed */
+        HalfOpen,                                   /* a probe query decides whether to close the breaker again */
+    };
+
     enum class error_code : uint
     {
         NoError                                                     = 0,
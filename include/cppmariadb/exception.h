@@ -23,4 +23,25 @@ namespace cppmariadb
             { }
     };
 
+    struct timeout_exception : public exception
+    {
+        inline timeout_exception(const std::string& msg, error_code err, const std::string& q = std::string())
+            : exception(msg, err, q)
+            { }
+    };
+
+    struct circuit_open_exception : public exception
+    {
+        inline circuit_open_exception(const std::string& msg, error_code err, const std::string& q = std::string())
+            : exception(msg, err, q)
+            { }
+    };
+
+    struct overload_exception : public exception
+    {
+        inline overload_exception(const std::string& msg, error_code err, const std::string& q = std::string())
+            : exception(msg, err, q)
+            { }
+    };
+
 }
\ No newline at end of file
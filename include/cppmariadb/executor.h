@@ -0,0 +1,101 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/executor.h>
+#include <cppmariadb/forward/connection.h>
+
+namespace cppmariadb
+{
+
+    /* Thread per core executor. Each worker thread owns one connection per backend (created
+     * on first use by the worker itself) and executes the tasks submitted to it from a lock
+     * free multi producer single consumer queue. Connections, results and rows never leave
+     * the worker thread, the value returned by a task is passed back through a future. */
+    struct executor
+    {
+    public:
+        using factory_type = std::function<connection()>;
+
+    private:
+        struct task
+        {
+            std::atomic<task*>  next    { nullptr };
+            size_t              backend { 0 };
+
+            virtual void run    (connection& c) = 0;
+            virtual void fail   (std::exception_ptr ex) = 0;
+            virtual ~task() = default;
+        };
+
+        template<class R, class F>
+        struct task_impl;
+
+        struct stub_task
+            : public task
+        {
+            void run (connection&) override { }
+            void fail(std::exception_ptr) override { }
+        };
+
+        using connection_ptru_type = std::unique_ptr<connection>;
+
+        struct alignas(64) worker
+        {
+            std::atomic<task*>                  head;       // last pushed task (producers)
+            task*                               tail;       // next task to execute (consumer)
+            stub_task                           stub;
+            std::atomic<bool>                   sleeping;
+            std::mutex                          mutex;
+            std::condition_variable             cond;
+            std::vector<connection_ptru_type>   connections;
+            std::thread                         thread;
+
+            inline worker();
+        };
+
+        using worker_ptru_type = std::unique_ptr<worker>;
+
+        std::vector<factory_type>       _backends;
+        std::vector<worker_ptru_type>   _workers;
+        std::atomic<size_t>             _next;
+        std::atomic<bool>               _running;
+
+        static inline void  push    (worker& w, task* t);
+        static        task* pop     (worker& w);
+                      void  enqueue (size_t index, size_t backend, task* t);
+                      void  run     (worker& w);
+
+    public:
+        /* executes f(connection&) on the connection to the backend owned by the passed worker */
+        template<class F>
+        inline auto     submit  (size_t worker, size_t backend, F&& f)
+            -> std::future<decltype(f(std::declval<connection&>()))>;
+
+        template<class F>
+        inline auto     submit  (size_t worker, F&& f)
+            -> std::future<decltype(f(std::declval<connection&>()))>;
+
+        /* executes f on the next worker (round robin) */
+        template<class F>
+        inline auto     submit  (F&& f)
+            -> std::future<decltype(f(std::declval<connection&>()))>;
+
+        inline size_t   size    () const;
+
+        executor(std::vector<factory_type> backends, size_t workers = std::thread::hardware_concurrency());
+        ~executor();
+
+    private:
+        executor(const executor&) = delete;
+    };
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cppmariadb/config.h>
 #include <cppmariadb/forward/column.h>
 #include <cppmariadb/forward/field.h>
@@ -8,13 +9,28 @@
 namespace cppmariadb
 {
 
+    /* read only view on binary field data (std::span<const std::byte> for C++17) */
+    struct byte_span
+    {
+        const std::byte*    data;
+        size_t              size;
+
+        inline const std::byte* begin   () const;
+        inline const std::byte* end     () const;
+        inline bool             empty   () const;
+        inline std::byte        operator[](size_t i) const;
+    };
+
+    /* The field references the buffer of the fetched row, so do the std::string_view,
+     * byte_span and const char* values returned by get(). They are valid until the result
+     * fetches the next row (the row is rebound in place) or the result is freed. */
     struct field
     {
     private:
         using column_t = ::cppmariadb::column;
 
-        const row&      _row;
-        const size_t    _index;
+        const row*      _row;
+        size_t          _index;
         const char*     _data;
         size_t          _size;
 
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cppmariadb/config.h>
+
+namespace cppmariadb
+{
+
+    struct aggregate_column;
+
+    struct aggregate_value;
+
+    struct aggregate_result;
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cppmariadb/config.h>
+
+namespace cppmariadb
+{
+
+    struct retry_budget;
+
+    struct breaker;
+
+}
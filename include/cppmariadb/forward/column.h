@@ -7,6 +7,7 @@ namespace cppmariadb
 {
 
     struct column;
+    struct column_handle;
 
     using column_vector = std::vector<column>;
 
@@ -7,4 +7,6 @@ namespace cppmariadb
 
     struct database;
 
-}
\ No newline at end of file
+    struct connect_options;
+
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cppmariadb/config.h>
+
+namespace cppmariadb
+{
+
+    struct datetime;
+
+}
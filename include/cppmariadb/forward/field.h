@@ -6,5 +6,6 @@ namespace cppmariadb
 {
 
     struct field;
+    struct byte_span;
 
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <memory>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/connection.h>
+
+namespace cppmariadb
+{
+
+    struct pool;
+
+    using connection_ptr = std::shared_ptr<connection>;
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cppmariadb/config.h>
+
+namespace cppmariadb
+{
+
+    struct null_bitmap;
+    struct row_batch;
+
+}
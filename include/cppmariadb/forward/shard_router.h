@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cppmariadb/config.h>
+
+namespace cppmariadb
+{
+
+    struct shard_router;
+
+    struct multi_result;
+
+}
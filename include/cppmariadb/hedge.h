@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <vector>
+#include <cppmariadb/config.h>
+#include <cppmariadb/shard_router.h>
+#include <cppmariadb/forward/hedge.h>
+#include <cppmariadb/forward/balancer.h>
+#include <cppmariadb/forward/statement.h>
+
+namespace cppmariadb
+{
+
+    /* Hedging policy for latency critical reads. If the replica selected first did not answer
+     * within the hedge delay (by default the 95th percentile of the recent read latencies),
+     * the read is issued on a second replica as well. The first successful response wins, the
+     * query on the other replica is killed (or drained if the connection parameters are unknown).
+     * Each read earns budget tokens and each hedged read costs one token, so hedging adds at
+     * most budget * reads extra queries. */
+    struct hedge
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+        using duration   = std::chrono::microseconds;
+
+    private:
+        static constexpr size_t min_samples = 20;
+        static constexpr double max_tokens  = 10.0;
+
+        ::cppmariadb::balancer&         _balancer;
+        double                          _quantile;
+        double                          _budget;
+        double                          _tokens;
+        duration                        _delay;         // delay calculated from the samples
+        duration                        _fixed;         // delay set by the user (zero if unset)
+        std::vector<duration>           _samples;       // ring buffer of the recent latencies
+        size_t                          _window;
+        size_t                          _next;
+        size_t                          _reads;
+        size_t                          _hedged;
+        std::vector<std::future<void>>  _draining;      // queries of the losing replicas
+        mutable std::mutex              _mutex;
+
+        void record (duration d);
+        bool acquire();
+        void refund ();
+        void drain  (std::future<void> f);
+
+    public:
+               multi_result execute_stored  (const statement& s);
+        inline duration     delay           () const;
+        inline void         delay           (duration value);
+        inline void         quantile        (double value);
+        inline void         budget          (double value);
+        inline size_t       reads           () const;
+        inline size_t       hedged          () const;
+
+        inline hedge(::cppmariadb::balancer& b, size_t window = 1000);
+               ~hedge();
+
+    private:
+        hedge(const hedge&) = delete;
+    };
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/database.h>
+
+namespace cppmariadb {
+namespace __impl
+{
+
+    /* Background thread that aborts queries whose deadline expired by issuing
+     * KILL QUERY over a side connection. Each kill runs asynchronously with a connect
+     * timeout, so an unreachable server does not delay the deadlines of other servers. */
+    struct watchdog
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+    private:
+        enum class state
+        {
+            waiting,
+            firing,
+            fired,
+        };
+
+        struct entry
+        {
+            const connect_options&  options;
+            unsigned long           thread_id;
+            state                   status;
+        };
+
+        using entry_ptrs_type = std::shared_ptr<entry>;
+        using entry_map       = std::multimap<clock_type::time_point, entry_ptrs_type>;
+
+        entry_map                       _entries;
+        bool                            _running;
+        std::thread                     _thread;
+        std::mutex                      _mutex;
+        std::condition_variable         _cond;
+        std::vector<std::future<void>>  _kills;     /* running kills, finished ones until they are pruned */
+
+        void run();
+        void kill(entry_ptrs_type e);
+        void unwatch(const entry_map::iterator& it, const entry_ptrs_type& e);
+
+    public:
+        struct guard
+        {
+        private:
+            watchdog&           _owner;
+            entry_map::iterator _it;
+            entry_ptrs_type     _entry;
+
+        public:
+            inline bool fired() const;
+
+            inline guard(watchdog& owner, entry_map::iterator it, entry_ptrs_type e);
+            inline ~guard();
+
+        private:
+            guard(const guard&) = delete;
+        };
+
+        using guard_ptru_type = std::unique_ptr<guard>;
+
+        static watchdog&        instance();
+               guard_ptru_type  watch   (clock_type::time_point deadline, const connect_options& options, unsigned long thread_id);
+
+        ~watchdog();
+
+    private:
+        watchdog();
+    };
+
+    /* watchdog::guard ***************************************************************************/
+
+    inline bool watchdog::guard::fired() const
+    {
+        std::lock_guard<std::mutex> lock(_owner._mutex);
+        return _entry->status != state::waiting;
+    }
+
+    inline watchdog::guard::guard(watchdog& owner, entry_map::iterator it, entry_ptrs_type e)
+        : _owner(owner)
+        , _it   (it)
+        , _entry(std::move(e))
+        { }
+
+    inline watchdog::guard::~guard()
+        { _owner.unwatch(_it, _entry); }
+
+} }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdlib>
+#include <cppmariadb/aggregate_result.h>
+#include <cppmariadb/inline/decimal.inl>
+
+namespace cppmariadb
+{
+
+    /* aggregate_value ***************************************************************************/
+
+    inline double aggregate_value::result() const
+    {
+        switch (function)
+        {
+            case aggregate_function::Count:
+                return static_cast<double>(count);
+            case aggregate_function::Sum:
+                return is_exact ? exact.to_double() : value;
+            case aggregate_function::Avg:
+                return (count != 0 ? (is_exact ? exact.to_double() : value) / static_cast<double>(count) : 0.0);
+            default:
+                return std::strtod(text.c_str(), nullptr);
+        }
+    }
+
+    /* aggregate_result **************************************************************************/
+
+    inline const aggregate_result::group_map& aggregate_result::groups() const
+        { return _groups; }
+
+    inline size_t aggregate_result::size() const
+        { return _groups.size(); }
+
+    inline aggregate_result::aggregate_result(std::vector<size_t> group_columns, std::vector<aggregate_column> aggregates)
+        : _group_columns(std::move(group_columns))
+        , _aggregates   (std::move(aggregates))
+        { }
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cppmariadb/balancer.h>
+
+namespace cppmariadb
+{
+
+    /* balancer::backend *************************************************************************/
+
+    inline balancer::backend::backend(::cppmariadb::pool& p)
+        : replica   (p)
+        , latency   (0.0)
+        , inflight  (0)
+        , lag       (0)
+        , ejected   (false)
+        { }
+
+    /* balancer **********************************************************************************/
+
+    inline double balancer::score(const backend& b) const
+        { return b.latency.load(std::memory_order_relaxed) * static_cast<double>(b.inflight.load(std::memory_order_relaxed) + 1); }
+
+    inline connection_ptr balancer::acquire()
+        { return acquire(npos, nullptr); }
+
+    inline size_t balancer::size() const
+        { return _backends.size(); }
+
+    inline pool& balancer::replica(size_t i) const
+        { return _backends.at(i)->replica; }
+
+    inline double balancer::latency(size_t i) const
+        { return _backends.at(i)->latency.load(); }
+
+    inline size_t balancer::inflight(size_t i) const
+        { return _backends.at(i)->inflight.load(); }
+
+    inline long long balancer::lag(size_t i) const
+        { return _backends.at(i)->lag.load(); }
+
+    inline bool balancer::ejected(size_t i) const
+        { return _backends.at(i)->ejected.load(); }
+
+    inline void balancer::decay(double value)
+        { _decay = value; }
+
+    inline void balancer::max_lag(seconds value)
+        { _max_lag = value; }
+
+    inline void balancer::restore_lag(seconds value)
+        { _restore_lag = value; }
+
+    inline balancer::balancer(const std::vector<pool*>& replicas)
+        : _decay        (0.2)
+        , _max_lag      (30)
+        , _restore_lag  (10)
+    {
+        _backends.reserve(replicas.size());
+        for (auto p : replicas)
+            _backends.emplace_back(new backend(*p));
+    }
+
+}
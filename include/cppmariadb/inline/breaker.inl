@@ -0,0 +1,159 @@
+#pragma once
+
+#include <exception>
+#include <algorithm>
+#include <cppmariadb/pool.h>
+#include <cppmariadb/breaker.h>
+#include <cppmariadb/database.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/pool.inl>
+
+namespace cppmariadb
+{
+
+    /* retry_budget ******************************************************************************/
+
+    inline void retry_budget::deposit()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tokens = std::min(_max, _tokens + _ratio);
+    }
+
+    inline bool retry_budget::withdraw()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tokens < 1.0)
+            return false;
+        _tokens -= 1.0;
+        return true;
+    }
+
+    inline double retry_budget::tokens() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _tokens;
+    }
+
+    inline retry_budget::retry_budget(double ratio, double max)
+        : _ratio    (ratio)
+        , _max      (max)
+        , _tokens   (0.0)
+        { }
+
+    /* breaker ***********************************************************************************/
+
+    inline bool breaker::retry(error_class_t c, bool idempotent)
+    {
+        return c == error_class_t::Connection
+            && idempotent
+            && _budget
+            && _budget->withdraw();
+    }
+
+    template<class F>
+    inline auto breaker::execute(F&& f, bool idempotent)
+        -> decltype(f(std::declval<connection&>()))
+    {
+        /* records the success of f (also for void results) if it did not throw */
+        struct success_guard
+        {
+            breaker&    owner;
+            int         exceptions;
+
+            inline ~success_guard()
+            {
+                if (std::uncaught_exceptions() == exceptions)
+                    owner.record(error_class_t::None);
+            }
+        };
+
+        if (_budget)
+            _budget->deposit();
+        while (true)
+        {
+            admit();
+
+            connection_ptr con;
+            try
+            {
+                con = _pool.acquire();
+            }
+            catch(const exception& ex)
+            {
+                auto c = database::error_class(ex.error);
+                record(c);
+                if (!retry(c, true))
+                    throw;
+                continue;
+            }
+
+            try
+            {
+                success_guard guard { *this, std::uncaught_exceptions() };
+                return f(*con);
+            }
+            catch(const exception& ex)
+            {
+                auto c = database::error_class(ex.error);
+                record(c);
+
+                /* do not return broken connections to the pool */
+                if (c == error_class_t::Connection)
+                    con->close();
+                if (!retry(c, idempotent))
+                    throw;
+            }
+        }
+    }
+
+    inline breaker::state_t breaker::state() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _state;
+    }
+
+    inline void breaker::probe(const std::string& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _probe = value;
+    }
+
+    inline void breaker::cooldown(duration value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cooldown = value;
+    }
+
+    inline void breaker::min_requests(size_t value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _min_requests = value;
+    }
+
+    inline void breaker::connection_threshold(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _connection_threshold = value;
+    }
+
+    inline void breaker::query_threshold(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _query_threshold = value;
+    }
+
+    inline breaker::breaker(::cppmariadb::pool& p, retry_budget* budget, size_t buckets, duration bucket_width)
+        : _pool                 (p)
+        , _budget               (budget)
+        , _probe                ("SELECT 1")
+        , _state                (state_t::Closed)
+        , _buckets              (buckets)
+        , _bucket_width         (bucket_width)
+        , _cooldown             (5000)
+        , _min_requests         (20)
+        , _connection_threshold (0.5)
+        , _query_threshold      (1.0)
+        { }
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cppmariadb/column_cache.h>
+
+namespace cppmariadb
+{
+
+    /* column_cache ******************************************************************************/
+
+    inline size_t column_cache::size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    inline size_t column_cache::capacity() const
+        { return _capacity; }
+
+    inline void column_cache::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+        _lru.clear();
+    }
+
+    inline column_cache::column_cache(size_t capacity)
+        : _capacity(capacity)
+        { }
+
+}
@@ -2,6 +2,7 @@
 
 #include <cppmariadb/result.h>
 #include <cppmariadb/connection.h>
+#include <cppmariadb/column_cache.h>
 
 #include <cppmariadb/inline/result.inl>
 #include <cppmariadb/inline/database.inl>
@@ -33,25 +34,74 @@ namespace cppmariadb
     /* connection ********************************************************************************/
 
     template<class T>
-    typename T::result_type* connection::execute_internal(const std::string& cmd)
+    inline bool connection::try_execute(const std::string& cmd, MYSQL_RES*& res)
+    {
+        res = nullptr;
+        auto start = clock_type::now();
+        bool ret   = false;
+        if (mysql_real_query(*this, cmd.data(), cmd.size()) == 0)
+        {
+            res = T()(*this);
+            ret = (res || mysql_field_count(*this) == 0);
+        }
+        if (_observer)
+            _observer(clock_type::now() - start);
+        return ret;
+    }
+
+    template<class T>
+    typename T::result_type* connection::execute_internal(const std::string& cmd, const std::string* key)
     {
 #ifdef MARIADB_DEBUG
         log_global_message(debug) << "execute cppmariadb query: " << std::endl << cmd;
 #endif
         if (!handle())
             throw exception("invalid handle", error_code::Unknown, cmd);
+        database::thread_init();
         using result_type = typename T::result_type;
         _result.reset();
-        if (mysql_real_query(*this, cmd.data(), cmd.size()) != 0)
-            throw exception(database::error_msg(*this), database::error_code(*this), cmd);
-        auto ret = T()(*this);
-        if (!ret)
+
+        std::string tmp;
+        auto query = &cmd;
+        if (_deadline != time_point::max())
+        {
+            tmp   = apply_deadline(cmd);
+            query = &tmp;
+        }
+        auto guard = watch_deadline();
+
+        MYSQL_RES* ret;
+        if (!try_execute<T>(*query, ret))
         {
-            if (mysql_field_count(*this) > 0)
+            auto err = database::error_code(*this);
+            if (    _deadline != time_point::max()
+                && (    (guard && guard->fired())
+                    ||  err == error_code::QueryInterrupted
+                    ||  err == error_code::StatementTimeout))
+                throw timeout_exception(database::error_msg(*this), err, cmd);
+            if (    !_auto_reconnect
+                ||  in_transaction()
+                ||  !database::connection_lost(err))
+                throw exception(database::error_msg(*this), err, cmd);
+
+            /* the session is gone anyway, so we reconnect in any case, but only
+             * statements that are safe to be executed twice are retried */
+            auto msg  = database::error_msg(*this);
+            auto type = database::query_type(cmd);
+            reconnect();
+            if (    type != query_type::Read
+                &&  type != query_type::Session)
+                throw exception(msg, err, cmd);
+            guard = watch_deadline();
+            if (!try_execute<T>(*query, ret))
                 throw exception(database::error_msg(*this), database::error_code(*this), cmd);
-            return nullptr;
         }
+        track_session(cmd);
+        if (!ret)
+            return nullptr;
         _result.reset(new result_type(ret));
+        if (_metadata_cache)
+            _result->_shared_columns = _metadata_cache->lookup(key ? *key : cmd, ret);
         return static_cast<result_type*>(_result.get());
     }
 
@@ -92,10 +142,10 @@ namespace cppmariadb
         { return execute_rows(s.query(*this)); }
 
     inline result_stored* connection::execute_stored(const statement& s)
-        { return execute_stored(s.query(*this)); }
+        { return execute_internal<op_store_result>(s.query(*this), &s.code()); }
 
     inline result_used* connection::execute_used(const statement& s)
-        { return execute_used(s.query(*this)); }
+        { return execute_internal<op_use_result>(s.query(*this), &s.code()); }
 
     inline result* connection::result() const
         { return _result.get(); }
@@ -116,6 +166,15 @@ namespace cppmariadb
         return value;
     }
 
+    inline unsigned long connection::thread_id() const
+        { return mysql_thread_id(handle()); }
+
+    inline bool connection::ping() const
+        { return handle() && mysql_ping(handle()) == 0; }
+
+    inline void connection::free_result()
+        { _result.reset(); }
+
     inline void connection::close()
     {
         _result.reset();
@@ -125,11 +184,71 @@ namespace cppmariadb
             mysql_close(h);
     }
 
+    inline const connect_options* connection::options() const
+        { return _options.get(); }
+
+    inline bool connection::auto_reconnect() const
+        { return _auto_reconnect; }
+
+    inline void connection::auto_reconnect(bool value)
+    {
+        if (value && !_options)
+            throw exception("unable to enable auto reconnect: connection parameters are unknown", error_code::Unknown);
+        _auto_reconnect = value;
+    }
+
+    inline const std::vector<std::string>& connection::session() const
+        { return _session; }
+
+    inline const connection::session_state_type& connection::session_state() const
+        { return _state; }
+
+    inline connection::time_point connection::deadline() const
+        { return _deadline; }
+
+    inline void connection::deadline(time_point value)
+        { _deadline = value; }
+
+    inline connection::server_timeout_t connection::server_timeout() const
+        { return _server_timeout; }
+
+    inline void connection::server_timeout(server_timeout_t value)
+        { _server_timeout = value; }
+
+    inline const connection::observer_type& connection::observer() const
+        { return _observer; }
+
+    inline void connection::observer(observer_type value)
+        { _observer = std::move(value); }
+
+    inline connection::column_cache_t* connection::metadata_cache() const
+        { return _metadata_cache; }
+
+    inline void connection::metadata_cache(column_cache_t* value)
+        { _metadata_cache = value; }
+
+    inline connection::guard_ptru_type connection::watch_deadline() const
+    {
+        if (_deadline == time_point::max() || !_options || !handle())
+            return guard_ptru_type();
+        return __impl::watchdog::instance().watch(_deadline, *_options, thread_id());
+    }
+
     inline connection& connection::operator =(connection&& other)
     {
         close();
         handle(other.handle());
         other.handle(nullptr);
+        _result         = std::move(other._result);
+        _options        = std::move(other._options);
+        _auto_reconnect = other._auto_reconnect;
+        _transaction    = other._transaction;
+        _session        = std::move(other._session);
+        _state          = std::move(other._state);
+        _deadline       = other._deadline;
+        _server_timeout = other._server_timeout;
+        _metadata_cache = other._metadata_cache;
+        _observer       = std::move(other._observer);
         return *this;
     }
 
@@ -138,12 +257,39 @@ namespace cppmariadb
         { }
 
     inline connection::connection(MYSQL* h)
-        : mariadb_handle(h)
+        : mariadb_handle    (h)
+        , _auto_reconnect   (false)
+        , _transaction      (false)
+        , _deadline         (time_point::max())
+        , _server_timeout   (server_timeout_t::None)
+        , _metadata_cache   (nullptr)
         { }
 
+    inline connection::connection(MYSQL* h, const connect_options& options)
+        : mariadb_handle    (h)
+        , _options          (new connect_options(options))
+        , _auto_reconnect   (false)
+        , _transaction      (false)
+        , _deadline         (time_point::max())
+        , _server_timeout   (server_timeout_t::None)
+        , _metadata_cache   (nullptr)
+    {
+        if (!options.database.empty())
+            _state["schema"] = options.database;
+    }
+
     inline connection::connection(connection&& other)
-        : mariadb_handle(std::move(other))
-        , _result       (std::move(other)._result)
+        : mariadb_handle    (std::move(other))
+        , _result           (std::move(other)._result)
+        , _options          (std::move(other)._options)
+        , _auto_reconnect   (other._auto_reconnect)
+        , _transaction      (other._transaction)
+        , _session          (std::move(other)._session)
+        , _state            (std::move(other)._state)
+        , _deadline         (other._deadline)
+        , _server_timeout   (other._server_timeout)
+        , _metadata_cache   (other._metadata_cache)
+        , _observer         (std::move(other._observer))
         { }
 
     inline connection::~connection()
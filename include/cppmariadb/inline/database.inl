@@ -14,23 +14,39 @@ namespace cppmariadb
         const std::string&  password,
         const std::string&  database,
         const client_flags& flags)
+        { return connect(connect_options { host, port, user, password, database, flags }); }
+
+    inline connection database::connect(const connect_options& options, std::chrono::seconds timeout)
     {
+        thread_init();
         auto handle = mysql_init(nullptr);
         if (!handle)
             throw exception("unable to initialize connection handle", error_code::Unknown);
 
+        if (timeout != std::chrono::seconds::zero())
+        {
+            auto value = static_cast<unsigned int>(timeout.count());
+            mysql_options(handle, MYSQL_OPT_CONNECT_TIMEOUT, &value);
+            mysql_options(handle, MYSQL_OPT_READ_TIMEOUT,    &value);
+            mysql_options(handle, MYSQL_OPT_WRITE_TIMEOUT,   &value);
+        }
+
         if (!mysql_real_connect(
                 handle,
-                host.c_str(),
-                user.c_str(),
-                password.c_str(),
-                database.empty() ? static_cast<const char*>(nullptr) : database.c_str(),
-                port,
+                options.host.c_str(),
+                options.user.c_str(),
+                options.password.c_str(),
+                options.database.empty() ? static_cast<const char*>(nullptr) : options.database.c_str(),
+                options.port,
                 nullptr,
-                flags.value))
-            throw exception(database::error_msg(handle), database::error_code(handle));
+                options.flags.value))
+        {
+            exception ex(database::error_msg(handle), database::error_code(handle));
+            mysql_close(handle);
+            throw ex;
+        }
 
-        return connection(handle);
+        return connection(handle, options);
     }
 
     inline error_code database::error_code(MYSQL* handle)
@@ -44,5 +60,38 @@ namespace cppmariadb
         auto ret = mysql_error(handle);
         return (ret ? std::string(ret) : std::string());
     }
+
+    inline bool database::connection_lost(error_code_t err)
+    {
+        switch (err)
+        {
+            case error_code::ClientServerGoneError:
+            case error_code::ClientServerLost:
+            case error_code::ClientServerLostExtended:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    inline error_class database::error_class(error_code_t err)
+    {
+        auto value = static_cast<uint>(err);
+        if (err == error_code::NoError)
+            return error_class_t::None;
+        if (value >= 2000 && value < 3000)
+            return error_class_t::Connection;
+        switch (err)
+        {
+            case error_code::ConCountError:
+            case error_code::TooManyUserConnections:
+            case error_code::ServerShutdown:
+            case error_code::HostIsBlocked:
+            case error_code::AbortingConnection:
+                return error_class_t::Connection;
+            default:
+                return error_class_t::Query;
+        }
+    }
     
 }
\ No newline at end of file
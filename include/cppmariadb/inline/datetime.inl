@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cppmariadb/datetime.h>
+#include <cppmariadb/exception.h>
+
+namespace cppmariadb
+{
+
+    namespace __impl
+    {
+
+        /* fixed width parsers, invalid characters are collected in 'bad' instead of branching
+         * on every single digit */
+
+        inline unsigned parse_digits(const char* c, size_t n, unsigned& bad)
+        {
+            unsigned ret = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto d = static_cast<unsigned>(static_cast<unsigned char>(c[i])) - '0';
+                bad |= (d > 9);
+                ret  = ret * 10 + d;
+            }
+            return ret;
+        }
+
+        /* 1 to 6 digits of a second fraction, scaled to microseconds */
+        inline unsigned parse_fraction(const char* c, size_t n, unsigned& bad)
+        {
+            static const unsigned scale[] = { 1, 100000, 10000, 1000, 100, 10, 1 };
+            bad |= (n == 0 || n > 6);
+            return n <= 6 ? parse_digits(c, n, bad) * scale[n] : 0;
+        }
+
+        /* days of the month in the proleptic gregorian calendar, 31 for the zero month of zero dates */
+        inline unsigned days_in_month(int y, unsigned m)
+        {
+            static const unsigned days[] = { 31, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            auto leap = (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0));
+            return m <= 12 ? days[m] + (m == 2 && leap) : 0;
+        }
+
+        /* YYYY-MM-DD, zero month and day (of zero dates) are accepted */
+        inline bool parse_date(const char* c, size_t s, datetime& ret)
+        {
+            if (s < 10)
+                return false;
+            unsigned bad = (c[4] != '-') | (c[7] != '-');
+            ret.year  = static_cast<int>(parse_digits(c, 4, bad));
+            ret.month = parse_digits(c + 5, 2, bad);
+            ret.day   = parse_digits(c + 8, 2, bad);
+            bad |= (ret.month > 12) | (ret.day > days_in_month(ret.year, ret.month));
+            return !bad;
+        }
+
+        /* YYYY-MM-DD HH:MM:SS[.ffffff] */
+        inline bool parse_datetime(const char* c, size_t s, datetime& ret)
+        {
+            if (s < 19 || !parse_date(c, s, ret))
+                return false;
+            unsigned bad = (c[10] != ' ' && c[10] != 'T') | (c[13] != ':') | (c[16] != ':');
+            ret.hour        = parse_digits(c + 11, 2, bad);
+            ret.minute      = parse_digits(c + 14, 2, bad);
+            ret.second      = parse_digits(c + 17, 2, bad);
+            ret.microsecond = 0;
+            bad |= (ret.hour > 23) | (ret.minute > 59) | (ret.second > 59);
+            if (s > 19)
+            {
+                bad |= (c[19] != '.');
+                ret.microsecond = parse_fraction(c + 20, s - 20, bad);
+            }
+            return !bad;
+        }
+
+        /* [-]HHH:MM:SS[.ffffff] with one to three digits of hours */
+        inline bool parse_time(const char* c, size_t s, std::chrono::microseconds& ret)
+        {
+            auto negative = (s > 0 && *c == '-');
+            c += negative;
+            s -= negative;
+            size_t h = 0;
+            while (h < s && h < 4 && c[h] != ':')
+                ++h;
+            if (h == 0 || h > 3 || s < h + 6)
+                return false;
+            unsigned bad  = (c[h + 3] != ':');
+            auto hours    = parse_digits(c,         h, bad);
+            auto minutes  = parse_digits(c + h + 1, 2, bad);
+            auto seconds  = parse_digits(c + h + 4, 2, bad);
+            unsigned frac = 0;
+            bad |= (minutes > 59) | (seconds > 59);
+            if (s > h + 6)
+            {
+                bad |= (c[h + 6] != '.');
+                frac = parse_fraction(c + h + 7, s - h - 7, bad);
+            }
+            if (bad)
+                return false;
+            auto value = (static_cast<long long>(hours) * 3600 + minutes * 60 + seconds) * 1000000 + frac;
+            ret = std::chrono::microseconds(negative ? -value : value);
+            return true;
+        }
+
+        /* days since 1970-01-01 of the proleptic gregorian calendar */
+        inline long long days_from_civil(int y, unsigned m, unsigned d)
+        {
+            y -= (m <= 2);
+            const int      era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(y - era * 400);
+            const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return static_cast<long long>(era) * 146097 + static_cast<long long>(doe) - 719468;
+        }
+
+    }
+
+    /* datetime **********************************************************************************/
+
+    inline std::chrono::system_clock::time_point datetime::to_time_point() const
+    {
+        using namespace std::chrono;
+        if (month == 0 || day == 0)
+            throw exception("unable to convert zero date to time point", error_code::UnknownError);
+        if (    day         > __impl::days_in_month(year, month)
+            ||  hour        > 23
+            ||  minute      > 59
+            ||  second      > 59
+            ||  microsecond > 999999)
+            throw exception("unable to convert invalid date to time point", error_code::UnknownError);
+        auto secs = __impl::days_from_civil(year, month, day) * 86400
+                  + static_cast<long long>(hour) * 3600
+                  + minute * 60
+                  + second;
+        return system_clock::time_point(duration_cast<system_clock::duration>(
+            seconds(secs) + microseconds(microsecond)));
+    }
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <cppmariadb/decimal.h>
+
+namespace cppmariadb
+{
+
+    /* decimal ***********************************************************************************/
+
+    inline std::string decimal::to_string() const
+    {
+        std::string ret;
+        auto v = unscaled < 0
+            ? static_cast<uvalue_type>(0) - static_cast<uvalue_type>(unscaled)
+            : static_cast<uvalue_type>(unscaled);
+        unsigned n = 0;
+        do
+        {
+            ret.push_back(static_cast<char>('0' + static_cast<unsigned>(v % 10)));
+            v /= 10;
+            if (++n == scale)
+                ret.push_back('.');
+        }
+        while (v || n <= scale);
+        if (unscaled < 0)
+            ret.push_back('-');
+        std::reverse(ret.begin(), ret.end());
+        return ret;
+    }
+
+    inline double decimal::to_double() const
+        { return static_cast<double>(unscaled) / std::pow(10.0, static_cast<double>(scale)); }
+
+    inline bool decimal::operator==(const decimal& other) const
+    {
+        auto a = *this;
+        auto b = other;
+        if (a.scale > b.scale)
+            std::swap(a, b);
+        /* a value that overflows when scaled up can not be equal to one that fits */
+        auto limit = std::numeric_limits<value_type>::max() / 10;
+        for (; a.scale < b.scale; ++a.scale)
+        {
+            if (a.unscaled > limit || a.unscaled < -limit)
+                return false;
+            a.unscaled *= 10;
+        }
+        return a.unscaled == b.unscaled;
+    }
+
+    inline bool decimal::operator!=(const decimal& other) const
+        { return !(*this == other); }
+
+    inline int decimal::compare(decimal a, decimal b)
+    {
+        /* scale the value with the smaller scale up, if it overflows it has the larger magnitude */
+        auto& x     = (a.scale < b.scale ? a : b);
+        auto  scale = std::max(a.scale, b.scale);
+        auto  limit = std::numeric_limits<value_type>::max() / 10;
+        for (; x.scale < scale; ++x.scale)
+        {
+            if (x.unscaled > limit || x.unscaled < -limit)
+                return ((&x == &a) == (x.unscaled > 0)) ? 1 : -1;
+            x.unscaled *= 10;
+        }
+        return a.unscaled < b.unscaled ? -1 : (a.unscaled > b.unscaled ? 1 : 0);
+    }
+
+    inline bool decimal::parse(const char* c, size_t s, unsigned scale, decimal& ret)
+    {
+        auto end      = c + s;
+        auto negative = (c != end && *c == '-');
+        if (c != end && (*c == '-' || *c == '+'))
+            ++c;
+
+        uvalue_type v      = 0;
+        unsigned    digits = 0;
+        unsigned    frac   = 0;
+        bool        dot    = false;
+        bool        any    = false;
+        for (; c != end; ++c)
+        {
+            if (*c == '.' && !dot)
+            {
+                dot = true;
+                continue;
+            }
+            auto d = static_cast<unsigned>(static_cast<unsigned char>(*c)) - '0';
+            if (d > 9)
+                return false;
+            any     = true;
+            frac   += dot;
+            digits += (v != 0 || d != 0);
+            if (digits > max_digits)
+                return false;
+            v = v * 10 + d;
+        }
+        if (!any)
+            return false;
+
+        if (scale == auto_scale)
+            scale = frac;
+        if (frac > scale)
+            return false;
+        for (; frac < scale; ++frac)
+        {
+            digits += (v != 0);
+            if (digits > max_digits)
+                return false;
+            v *= 10;
+        }
+
+        ret.unscaled = negative
+            ? -static_cast<value_type>(v)
+            : static_cast<value_type>(v);
+        ret.scale    = scale;
+        return true;
+    }
+
+}
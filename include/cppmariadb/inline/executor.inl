@@ -0,0 +1,89 @@
+#pragma once
+
+#include <type_traits>
+#include <cppmariadb/executor.h>
+
+namespace cppmariadb
+{
+
+    /* executor::task_impl ***********************************************************************/
+
+    template<class R, class F>
+    struct executor::task_impl
+        : public task
+    {
+        F               func;
+        std::promise<R> promise;
+
+        void run(connection& c) override
+        {
+            try
+            {
+                if constexpr (std::is_void<R>::value)
+                {
+                    func(c);
+                    promise.set_value();
+                }
+                else
+                    promise.set_value(func(c));
+            }
+            catch(...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        }
+
+        void fail(std::exception_ptr ex) override
+            { promise.set_exception(ex); }
+
+        template<class X>
+        inline task_impl(X&& f)
+            : func(std::forward<X>(f))
+            { }
+    };
+
+    /* executor::worker **************************************************************************/
+
+    inline executor::worker::worker()
+        : head      (&stub)
+        , tail      (&stub)
+        , sleeping  (false)
+        { }
+
+    /* executor **********************************************************************************/
+
+    inline void executor::push(worker& w, task* t)
+    {
+        t->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = w.head.exchange(t, std::memory_order_acq_rel);
+        prev->next.store(t, std::memory_order_release);
+    }
+
+    template<class F>
+    inline auto executor::submit(size_t worker, size_t backend, F&& f)
+        -> std::future<decltype(f(std::declval<connection&>()))>
+    {
+        using result_type = decltype(f(std::declval<connection&>()));
+        using task_type   = task_impl<result_type, typename std::decay<F>::type>;
+
+        std::unique_ptr<task_type> t(new task_type(std::forward<F>(f)));
+        auto ret = t->promise.get_future();
+        enqueue(worker, backend, t.get());
+        t.release();
+        return ret;
+    }
+
+    template<class F>
+    inline auto executor::submit(size_t worker, F&& f)
+        -> std::future<decltype(f(std::declval<connection&>()))>
+        { return submit(worker, 0, std::forward<F>(f)); }
+
+    template<class F>
+    inline auto executor::submit(F&& f)
+        -> std::future<decltype(f(std::declval<connection&>()))>
+        { return submit(_next.fetch_add(1, std::memory_order_relaxed) % _workers.size(), 0, std::forward<F>(f)); }
+
+    inline size_t executor::size() const
+        { return _workers.size(); }
+
+}
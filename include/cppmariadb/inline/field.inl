@@ -1,7 +1,18 @@
 #pragma once
 
+#include <chrono>
+#include <utility>
+#include <charconv>
+#include <type_traits>
+#include <string_view>
 #include <cppmariadb/row.h>
 #include <cppmariadb/field.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/decimal.h>
+#include <cppmariadb/datetime.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/inline/decimal.inl>
+#include <cppmariadb/inline/datetime.inl>
 #include <cpputils/misc/enum.h>
 #include <cpputils/misc/string.h>
 
@@ -10,22 +21,69 @@ namespace cppmariadb
 
     /* op_field_converter ************************************************************************/
 
-    template<class T, class Enable = void>
-    struct op_field_converter;
+    [[noreturn]] inline void throw_field_conversion_error(const char* c, size_t s)
+        { throw exception(std::string("unable to convert field data (data=") + std::string(c, s) + ")", error_code::UnknownError); }
 
-    template<typename T>
-    struct op_field_converter<T, void>
+    template<class T, class Enable = void>
+    struct op_field_converter
     {
         inline T operator()(const char* c, size_t s) const
         {
             T tmp;
             std::string data(c, s);
             if (!utl::try_from_string(data, tmp))
-                throw exception(std::string("unable to convert field data (data=") + data + ")", error_code::UnknownError);
+                throw_field_conversion_error(c, s);
+            return tmp;
+        }
+    };
+
+    /* integers and floating point values are parsed in place without any allocation */
+    template<typename T>
+    struct op_field_converter<T, typename std::enable_if<
+            std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type>
+    {
+        inline T operator()(const char* c, size_t s) const
+        {
+            T tmp;
+            auto end = c + s;
+            auto ret = std::from_chars(c, end, tmp);
+            if (ret.ec != std::errc() || ret.ptr != end)
+                throw_field_conversion_error(c, s);
             return tmp;
         }
     };
 
+    /* accepts any integer (non zero is true) and "true" or "false" in any case */
+    template<>
+    struct op_field_converter<bool, void>
+    {
+        static inline bool equals(const char* c, size_t s, const char* literal)
+        {
+            for (size_t i = 0; i < s; ++i, ++literal)
+            {
+                if (!*literal || (c[i] | 0x20) != *literal)
+                    return false;
+            }
+            return !*literal;
+        }
+
+        inline bool operator()(const char* c, size_t s) const
+        {
+            if (s == 1 && (*c == '0' || *c == '1'))
+                return (*c == '1');
+            long long tmp;
+            auto end = c + s;
+            auto ret = std::from_chars(c, end, tmp);
+            if (ret.ec == std::errc() && ret.ptr == end)
+                return (tmp != 0);
+            if (equals(c, s, "true"))
+                return true;
+            if (equals(c, s, "false"))
+                return false;
+            throw_field_conversion_error(c, s);
+        }
+    };
+
     template<>
     struct op_field_converter<const char*, void>
     {
@@ -33,6 +91,20 @@ namespace cppmariadb
             { return c; }
     };
 
+    template<>
+    struct op_field_converter<std::string_view, void>
+    {
+        inline std::string_view operator()(const char* c, size_t s) const
+            { return std::string_view(c, s); }
+    };
+
+    template<>
+    struct op_field_converter<byte_span, void>
+    {
+        inline byte_span operator()(const char* c, size_t s) const
+            { return byte_span { reinterpret_cast<const std::byte*>(c), s }; }
+    };
+
     template<>
     struct op_field_converter<std::string, void>
     {
@@ -40,13 +112,129 @@ namespace cppmariadb
             { return std::string(c, s); }
     };
 
+    /* converters that take the column as third argument choose the format by its type */
+
+    template<>
+    struct op_field_converter<datetime, void>
+    {
+        inline datetime operator()(const char* c, size_t s, const column& col) const
+        {
+            datetime ret;
+            bool ok;
+            switch (col.type)
+            {
+                case column_type::Date:
+                case column_type::NewDate:
+                    ok = (s == 10) && __impl::parse_date(c, s, ret);
+                    break;
+                case column_type::Time:
+                case column_type::Time2:
+                    ok = false;
+                    break;
+                case column_type::DateTime:
+                case column_type::DateTime2:
+                case column_type::Timestamp:
+                case column_type::Timestamp2:
+                    ok = __impl::parse_datetime(c, s, ret);
+                    break;
+                default:
+                    ok = (s == 10)
+                        ? __impl::parse_date(c, s, ret)
+                        : __impl::parse_datetime(c, s, ret);
+                    break;
+            }
+            if (!ok)
+                throw_field_conversion_error(c, s);
+            return ret;
+        }
+    };
+
+    template<>
+    struct op_field_converter<std::chrono::system_clock::time_point, void>
+    {
+        inline std::chrono::system_clock::time_point operator()(const char* c, size_t s, const column& col) const
+            { return op_field_converter<datetime>()(c, s, col).to_time_point(); }
+    };
+
+    template<>
+    struct op_field_converter<std::chrono::microseconds, void>
+    {
+        inline std::chrono::microseconds operator()(const char* c, size_t s, const column& col) const
+        {
+            std::chrono::microseconds ret;
+            bool ok;
+            switch (col.type)
+            {
+                case column_type::Date:
+                case column_type::NewDate:
+                case column_type::DateTime:
+                case column_type::DateTime2:
+                case column_type::Timestamp:
+                case column_type::Timestamp2:
+                    ok = false;
+                    break;
+                default:
+                    ok = __impl::parse_time(c, s, ret);
+                    break;
+            }
+            if (!ok)
+                throw_field_conversion_error(c, s);
+            return ret;
+        }
+    };
+
+    /* the scale of DECIMAL columns is taken from the column, other columns use the number
+     * of fraction digits of the value */
+    template<>
+    struct op_field_converter<decimal, void>
+    {
+        inline decimal operator()(const char* c, size_t s, const column& col) const
+        {
+            auto fixed = (col.type == column_type::Decimal || col.type == column_type::NewDecimal);
+            decimal ret;
+            if (!decimal::parse(c, s, fixed ? col.decimals : decimal::auto_scale, ret))
+                throw_field_conversion_error(c, s);
+            return ret;
+        }
+    };
+
+    namespace __impl
+    {
+
+        template<class T, class Enable = void>
+        struct is_typed_field_converter
+            : public std::false_type
+            { };
+
+        template<class T>
+        struct is_typed_field_converter<T, decltype(void(std::declval<const op_field_converter<T>&>()(
+                std::declval<const char*>(), std::declval<size_t>(), std::declval<const column&>())))>
+            : public std::true_type
+            { };
+
+    }
+
+    /* byte_span *********************************************************************************/
+
+    inline const std::byte* byte_span::begin() const
+        { return data; }
+
+    inline const std::byte* byte_span::end() const
+        { return data + size; }
+
+    inline bool byte_span::empty() const
+        { return (size == 0); }
+
+    inline std::byte byte_span::operator[](size_t i) const
+        { return data[i]; }
+
     /* field *************************************************************************************/
 
     inline size_t field::index() const
         { return _index; }
 
     inline const column& field::column() const
-        { return _row.columns().at(_index); }
+        { return _row->columns().at(_index); }
 
     inline bool field::is_null() const
         { return (_data == nullptr); }
@@ -65,14 +253,17 @@ namespace cppmariadb
     {
         if (is_null())
             throw exception("field is null", error_code::UnknownError);
-        return op_field_converter<T>()(_data, _size);
+        if constexpr (__impl::is_typed_field_converter<T>::value)
+            return op_field_converter<T>()(_data, _size, column());
+        else
+            return op_field_converter<T>()(_data, _size);
     }
 
     inline field::operator bool() const
         { return !is_null() && !is_empty(); }
 
     inline field::field(const row& r, size_t i, const char* d, size_t s)
-            : _row  (r)
+            : _row  (&r)
             , _index(i)
             , _data (d)
             , _size (s)
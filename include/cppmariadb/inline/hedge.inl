@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cppmariadb/hedge.h>
+
+namespace cppmariadb
+{
+
+    /* hedge *************************************************************************************/
+
+    inline hedge::duration hedge::delay() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (_fixed != duration::zero())
+            ? _fixed
+            : _delay;
+    }
+
+    inline void hedge::delay(duration value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _fixed = value;
+    }
+
+    inline void hedge::quantile(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quantile = value;
+    }
+
+    inline void hedge::budget(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _budget = value;
+    }
+
+    inline size_t hedge::reads() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _reads;
+    }
+
+    inline size_t hedge::hedged() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hedged;
+    }
+
+    inline hedge::hedge(::cppmariadb::balancer& b, size_t window)
+        : _balancer (b)
+        , _quantile (0.95)
+        , _budget   (0.05)
+        , _tokens   (0.0)
+        , _delay    (duration::max())
+        , _fixed    (duration::zero())
+        , _window   (window)
+        , _next     (0)
+        , _reads    (0)
+        , _hedged   (0)
+        { _samples.reserve(window); }
+
+}
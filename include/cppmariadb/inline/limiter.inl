@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cppmariadb/limiter.h>
+
+namespace cppmariadb
+{
+
+    /* limiter ***********************************************************************************/
+
+    inline size_t limiter::limit() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<size_t>(_limit);
+    }
+
+    inline size_t limiter::inflight() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _inflight;
+    }
+
+    inline size_t limiter::queued() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queued;
+    }
+
+    inline double limiter::latency() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _short;
+    }
+
+    inline void limiter::min_limit(size_t value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _min_limit = static_cast<double>(value);
+    }
+
+    inline void limiter::max_limit(size_t value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _max_limit = static_cast<double>(value);
+    }
+
+    inline void limiter::max_queue(size_t value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _max_queue = value;
+    }
+
+    inline void limiter::smoothing(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _smoothing = value;
+    }
+
+    inline void limiter::tolerance(double value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tolerance = value;
+    }
+
+    inline limiter::limiter(::cppmariadb::pool& p, size_t initial_limit)
+        : _pool         (p)
+        , _limit        (static_cast<double>(initial_limit))
+        , _min_limit    (1.0)
+        , _max_limit    (1000.0)
+        , _smoothing    (0.2)
+        , _tolerance    (1.5)
+        , _short        (0.0)
+        , _long         (0.0)
+        , _inflight     (0)
+        , _queued       (0)
+        , _max_queue    (64)
+        { }
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cppmariadb/merge_result.h>
+
+namespace cppmariadb
+{
+
+    /* merge_result ******************************************************************************/
+
+    inline row* merge_result::current() const
+        { return _row; }
+
+    inline size_t merge_result::count() const
+        { return _count; }
+
+    inline merge_result::merge_result(std::vector<sort_column> order, size_t limit)
+        : _order(std::move(order))
+        , _limit(limit)
+        , _count(0)
+        , _last (npos)
+        , _row  (nullptr)
+        { }
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cppmariadb/pool.h>
+
+namespace cppmariadb
+{
+
+    /* pool **************************************************************************************/
+
+    inline size_t pool::size() const
+        { return _size; }
+
+    inline size_t pool::count() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+    inline size_t pool::idle() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _idle.size();
+    }
+
+    inline bool pool::reset() const
+        { return _reset; }
+
+    inline void pool::reset(bool value)
+        { _reset = value; }
+
+    inline pool::pool(factory_type factory, size_t size)
+        : _factory          (std::move(factory))
+        , _size             (size)
+        , _count            (0)
+        , _reset            (false)
+        , _ping_interval    (std::chrono::seconds(30))
+        , _max_idle         (duration::zero())
+        , _running          (false)
+        { }
+
+}
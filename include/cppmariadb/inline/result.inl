@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cppmariadb/result.h>
+#include <cppmariadb/inline/row.inl>
 
 namespace cppmariadb
 {
@@ -15,13 +16,23 @@ namespace cppmariadb
 
     inline const column_vector& result::columns() const
     {
+        if (_shared_columns)
+            return *_shared_columns;
         if (_columns.empty())
             update_columns();
         return _columns;
     }
 
+    inline size_t result::find(std::string_view name) const
+    {
+        if (_names.empty())
+            update_names();
+        auto it = _names.find(name);
+        return it != _names.end() ? it->second : npos;
+    }
+
     inline row* result::current() const
-        { return _row.get(); }
+        { return _row.handle() ? &_row : nullptr; }
 
     inline unsigned long long result::rowindex() const
         { return _rowindex; }
@@ -36,6 +47,7 @@ namespace cppmariadb
     inline result::result(MYSQL_RES* h)
         : mariadb_handle    (h)
         , _is_initialized   (false)
+        , _row              (*this, nullptr)
         , _rowindex         (static_cast<unsigned long long>(-1))
         { }
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cppmariadb/router.h>
+#include <cppmariadb/statement.h>
+
+#include <cppmariadb/inline/balancer.inl>
+#include <cppmariadb/inline/statement.inl>
+
+namespace cppmariadb
+{
+
+    /* router::session ***************************************************************************/
+
+    inline connection_ptr router::session::acquire(const statement& s)
+        { return acquire(s.type()); }
+
+    inline bool router::session::in_transaction() const
+        { return static_cast<bool>(_transaction); }
+
+    inline router::session::session(router& r)
+        : _router       (r)
+        , _last_write   ()
+        { }
+
+    /* router ************************************************************************************/
+
+    inline pool& router::primary() const
+        { return _primary; }
+
+    inline balancer& router::balancer()
+        { return _balancer; }
+
+    inline router::duration_type router::window() const
+        { return _window; }
+
+    inline router::router(pool& primary, const std::vector<pool*>& replicas, duration_type window)
+        : _primary  (primary)
+        , _balancer (replicas)
+        , _window   (window)
+        { }
+
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
 #include <cppmariadb/field.h>
 #include <cppmariadb/result.h>
+#include <cppmariadb/inline/field.inl>
 
 namespace cppmariadb
 {
@@ -26,33 +28,17 @@ namespace cppmariadb
     inline typename row::iterator_tpl<T>::reference
     row::iterator_tpl<T>::field() const
     {
-        if (!_cache)
-            _cache.reset(new value_type(_owner->at(_index)));
-        return *_cache;
-    }
-
-    template<typename T>
-    inline void row::iterator_tpl<T>::assign(const this_type& other)
-    {
-        _owner     = other._owner;
-        _index     = other._index;
-        _direction = other._direction;
-        _cache.reset();
+        _field = _owner->make_field(static_cast<size_t>(_index));
+        return _field;
     }
 
     template<typename T>
     inline void row::iterator_tpl<T>::next(difference_type i)
-    {
-        _cache.reset();
-        _index = _index + _direction * i;
-    }
+        { _index = _index + _direction * i; }
 
     template<typename T>
     inline void row::iterator_tpl<T>::prev(difference_type i)
-    {
-        _cache.reset();
-        _index = _index - _direction * i;
-    }
+        { _index = _index - _direction * i; }
 
     template<typename T>
     inline bool row::iterator_tpl<T>::operator==(const this_type& other) const
@@ -181,14 +167,23 @@ namespace cppmariadb
         : _owner    (&p_row)
         , _index    (index)
         , _direction(direction)
+        , _field    (p_row, 0, nullptr, 0)
         { }
 
-    template<typename T>
-    inline row::iterator_tpl<T>::iterator_tpl(const this_type& other)
-        { assign(other); }
-
     /* row ***************************************************************************************/
 
+    inline void row::bind(MYSQL_ROW p_row, unsigned long* p_lengths)
+    {
+        handle(p_row);
+        _lengths = p_lengths;
+    }
+
+    inline unsigned long* row::lengths() const
+        { return _lengths ? _lengths : fetch_lengths(); }
+
+    inline field row::make_field(size_t i) const
+        { return field(*this, i, handle()[i], lengths()[i]); }
+
     inline const column_vector& row::columns() const
         { return _result.columns(); }
 
@@ -219,16 +214,25 @@ namespace cppmariadb
     inline row::const_iterator_type row::crend() const
         { return const_iterator_type(*this, -1, -1); }
 
+    inline size_t row::find(std::string_view name) const
+        { return _result.find(name); }
+
+    inline field row::at(column_handle h) const
+        { return at(h.index); }
+
     inline field row::operator[](size_t i) const
         { return at(i); }
 
-    inline field row::operator[](const std::string& name) const
+    inline field row::operator[](std::string_view name) const
         { return at(name); }
 
-    inline row::row(const result& p_result, MYSQL_ROW p_row)
+    inline field row::operator[](column_handle h) const
+        { return at(h.index); }
+
+    inline row::row(const result& p_result, MYSQL_ROW p_row, unsigned long* p_lengths)
         : mariadb_handle(p_row)
         , _result       (p_result)
-        , _lengths      (nullptr)
+        , _lengths      (p_lengths)
         { }
         
 }
\ No newline at end of file
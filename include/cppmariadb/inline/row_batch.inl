@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <cppmariadb/row_batch.h>
+
+namespace cppmariadb
+{
+
+    /* null_bitmap *******************************************************************************/
+
+    inline bool null_bitmap::test(size_t i) const
+        { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    inline void null_bitmap::set(size_t i)
+        { words[i >> 6] |= (uint64_t(1) << (i & 63)); }
+
+    inline void null_bitmap::reset(size_t size)
+        { words.assign((size + 63) >> 6, 0); }
+
+    inline size_t null_bitmap::count() const
+    {
+        size_t ret = 0;
+        for (auto w : words)
+            ret += static_cast<size_t>(__builtin_popcountll(w));
+        return ret;
+    }
+
+    /* row_batch *********************************************************************************/
+
+    inline simd_level row_batch::simd() const
+        { return _simd; }
+
+    inline void row_batch::simd(simd_level value)
+        { _simd = std::min(value, detect_simd()); }
+
+    inline size_t row_batch::size() const
+        { return _rows.size(); }
+
+    inline size_t row_batch::columncount() const
+        { return _columns; }
+
+    inline void row_batch::clear()
+    {
+        _rows.clear();
+        _lengths.clear();
+    }
+
+    inline row_batch::row_batch()
+        : _columns  (0)
+        , _simd     (detect_simd())
+        { }
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cppmariadb/pool.h>
+#include <cppmariadb/scheduler.h>
+
+#include <cppmariadb/inline/pool.inl>
+
+namespace cppmariadb
+{
+
+    /* scheduler *********************************************************************************/
+
+    inline bool scheduler::allowed(size_t cls) const
+    {
+        return cls == 0
+            ? _inflight < _capacity
+            : _inflight + _reserved < _capacity;
+    }
+
+    inline size_t scheduler::classes() const
+        { return _queues.size(); }
+
+    inline scheduler::statistics scheduler::stats(size_t cls) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& q = _queues.at(cls);
+        auto ret = q.stats;
+        ret.waiting = q.waiters.size();
+        return ret;
+    }
+
+    inline void scheduler::aging(duration value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _aging = value;
+    }
+
+    inline scheduler::scheduler(::cppmariadb::pool& p, const std::vector<double>& weights, size_t reserved, size_t capacity)
+        : _pool     (p)
+        , _capacity (capacity ? capacity : p.size())
+        , _reserved (reserved)
+        , _inflight (0)
+        , _vtime    (0.0)
+        , _aging    (std::chrono::seconds(1))
+    {
+        _queues.reserve(weights.size());
+        for (auto w : weights)
+            _queues.emplace_back(queue { w, 0.0, { }, { } });
+    }
+
+}
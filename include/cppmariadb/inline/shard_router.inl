@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cppmariadb/pool.h>
+#include <cppmariadb/statement.h>
+#include <cppmariadb/shard_router.h>
+
+#include <cppmariadb/inline/pool.inl>
+#include <cppmariadb/inline/statement.inl>
+
+namespace cppmariadb
+{
+
+    /* multi_result ******************************************************************************/
+
+    inline void multi_result::add(connection_ptr con, result_stored* res)
+        { _results.emplace_back(std::move(con), res); }
+
+    inline size_t multi_result::size() const
+        { return _results.size(); }
+
+    inline result_stored* multi_result::at(size_t i) const
+        { return _results.at(i).second; }
+
+    inline row* multi_result::current() const
+        { return _row; }
+
+    inline multi_result::multi_result()
+        : _index(0)
+        , _row  (nullptr)
+        { }
+
+    /* shard_router ******************************************************************************/
+
+    inline shard_router::key_extractor shard_router::parameter(const std::string& name)
+        { return [name](const statement& s){ return s.value(name); }; }
+
+    inline size_t shard_router::size() const
+        { return _shards.size(); }
+
+    inline size_t shard_router::shard_for(const statement& s) const
+        { return shard_for(_extractor(s)); }
+
+    inline pool& shard_router::at(size_t i) const
+        { return *_shards.at(i).pool; }
+
+    inline connection_ptr shard_router::acquire(const std::string& key) const
+        { return at(shard_for(key)).acquire(); }
+
+    inline connection_ptr shard_router::acquire(const statement& s) const
+        { return at(shard_for(s)).acquire(); }
+
+    inline shard_router::shard_router(key_extractor extractor, size_t vnodes)
+        : _vnodes   (vnodes)
+        , _extractor(std::move(extractor))
+        { }
+
+}
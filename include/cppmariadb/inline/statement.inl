@@ -1,8 +1,12 @@
 #pragma once
 
+#include <type_traits>
 #include <cppmariadb/statement.h>
+#include <cppmariadb/database.h>
+#include <cppmariadb/decimal.h>
 #include <cpputils/misc/enum.h>
 #include <cpputils/misc/string.h>
+#include <cppmariadb/inline/decimal.inl>
 
 namespace cppmariadb
 {
@@ -12,6 +16,7 @@ namespace cppmariadb
     inline void statement::assign(const std::string& query)
     {
         _changed = true;
+        _type    = query_type::Unknown;
         parse(query);
     }
 
@@ -22,7 +27,10 @@ namespace cppmariadb
         return _query;
     }
 
-    inline size_t statement::find(const std::string& param)
+    inline const std::string& statement::code() const
+        { return _template; }
+
+    inline size_t statement::find(const std::string& param) const
     {
         for (size_t i = 0; i < _parameters.size(); ++i)
         {
@@ -32,6 +40,24 @@ namespace cppmariadb
         return npos;
     }
 
+    inline const std::string& statement::value(const std::string& param) const
+    {
+        auto i = find(param);
+        if (i == npos)
+            throw exception(std::string("unknown parameter name in query: ") + param, error_code::Unknown);
+        return value(i);
+    }
+
+    inline const std::string& statement::value(size_t index) const
+    {
+        if (index >= _parameters.size())
+            throw exception(std::string("unknown parameter index in query: ") + std::to_string(index), error_code::Unknown);
+        auto& param = _parameters.at(index);
+        if (!param.second.has_value)
+            throw exception(std::string("parameter has no value: ") + param.first, error_code::Unknown);
+        return param.second.value;
+    }
+
     inline void statement::set_null(const std::string& param)
     {
         auto i = find(param);
@@ -49,6 +75,18 @@ namespace cppmariadb
         _changed = true;
     }
 
+    inline query_type statement::type() const
+    {
+        if (_hint != query_type::Unknown)
+            return _hint;
+        if (_type == query_type::Unknown && !_code.empty())
+            _type = database::query_type(_code.front());
+        return _type;
+    }
+
+    inline void statement::type(query_type hint)
+        { _hint = hint; }
+
     inline bool statement::empty() const
         { return _code.empty(); }
 
@@ -74,18 +112,25 @@ namespace cppmariadb
             throw exception(std::string("unknown parameter index in query: ") + std::to_string(index), error_code::Unknown);
         auto& param = _parameters.at(index).second;
         param.has_value = true;
-        param.value = utl::to_string(value);
+        if constexpr (std::is_same<T, decimal>::value)
+            param.value = value.to_string();
+        else
+            param.value = utl::to_string(value);
         _changed = true;
     }
 
     inline statement::statement()
         : _changed      (true)
+        , _type         (query_type::Unknown)
         , _connection   (nullptr)
+        , _hint         (query_type::Unknown)
         { }
 
     inline statement::statement(const std::string& query)
         : _changed      (true)
+        , _type         (query_type::Unknown)
         , _connection   (nullptr)
+        , _hint         (query_type::Unknown)
         { parse(query); }
 
 
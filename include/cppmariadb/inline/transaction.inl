@@ -11,6 +11,7 @@ namespace cppmariadb
     {
         static const statement sCommit("START TRANSACTION");
         _connection.execute(sCommit);
+        _connection._transaction = true;
     }
 
     inline void transaction::commit()
@@ -19,7 +20,7 @@ namespace cppmariadb
         if (_closed)
             throw exception("transaction is already closed", error_code::Unknown);
         _connection.execute(sCommit);
-        _closed = true;
+        close();
     }
 
     inline void transaction::rollback()
@@ -27,15 +28,57 @@ namespace cppmariadb
         static const statement sRollback("ROLLBACK");
         if (_closed)
             throw exception("transaction is already closed", error_code::Unknown);
-        _connection.execute(sRollback);
+        close();
+
+        /* an expired deadline must not prevent the rollback */
+        auto deadline = _connection._deadline;
+        _connection._deadline = time_point::max();
+        try
+        {
+            _connection.execute(sRollback);
+        }
+        catch(const exception& ex)
+        {
+            _connection._deadline = deadline;
+            /* the server discards the transaction of a lost session,
+             * so there is nothing left to roll back after reconnecting */
+            if (    !_connection.auto_reconnect()
+                ||  !database::connection_lost(ex.error))
+                throw;
+        }
+        _connection._deadline = deadline;
+    }
+
+    inline void transaction::close()
+    {
+        _connection._transaction = false;
+        _connection._deadline    = _previous;
         _closed = true;
     }
 
     inline transaction::transaction(connection& connection) :
         _connection (connection),
-        _closed     (false)
+        _closed     (false),
+        _previous   (connection._deadline)
         { begin(); }
 
+    inline transaction::transaction(connection& connection, time_point deadline) :
+        _connection (connection),
+        _closed     (false),
+        _previous   (connection._deadline)
+    {
+        _connection._deadline = deadline;
+        try
+        {
+            begin();
+        }
+        catch(...)
+        {
+            _connection._deadline = _previous;
+            throw;
+        }
+    }
+
     inline transaction::~transaction()
     {
         if (!_closed)
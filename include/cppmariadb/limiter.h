@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/limiter.h>
+
+namespace cppmariadb
+{
+
+    /* Adaptive concurrency limit in front of a pool (gradient algorithm). The round trip time of
+     * the queries is tracked by a fast and a slow moving average. As long as both are about the same
+     * the limit grows by sqrt(limit), if the recent latency rises above the long term latency the
+     * limit shrinks by their ratio. Requests exceeding the limit are queued, requests exceeding
+     * the queue are rejected with an overload_exception. */
+    struct limiter
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+        using time_point = clock_type::time_point;
+
+    private:
+        ::cppmariadb::pool&         _pool;
+        double                      _limit;
+        double                      _min_limit;
+        double                      _max_limit;
+        double                      _smoothing;
+        double                      _tolerance;     // ratio of long to short latency that is still accepted
+        double                      _short;         // EWMA of the recent latencies in microseconds
+        double                      _long;          // EWMA of the long term latency in microseconds
+        size_t                      _inflight;
+        size_t                      _queued;
+        size_t                      _max_queue;
+        mutable std::mutex          _mutex;
+        std::condition_variable     _cond;
+
+        void record (clock_type::duration d);
+        void release();
+
+    public:
+               connection_ptr   acquire     (time_point deadline = time_point::max());
+        inline size_t           limit       () const;
+        inline size_t           inflight    () const;
+        inline size_t           queued      () const;
+        inline double           latency     () const;
+        inline void             min_limit   (size_t value);
+        inline void             max_limit   (size_t value);
+        inline void             max_queue   (size_t value);
+        inline void             smoothing   (double value);
+        inline void             tolerance   (double value);
+
+        inline limiter(::cppmariadb::pool& p, size_t initial_limit = 20);
+
+    private:
+        limiter(const limiter&) = delete;
+    };
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/row.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/result.h>
+#include <cppmariadb/forward/merge_result.h>
+
+namespace cppmariadb
+{
+
+    /* Numeric columns are compared exactly (as decimal). All other columns are compared byte by
+     * byte, so text sort columns must use a binary collation (e.g. ORDER BY name COLLATE utf8mb4_bin),
+     * otherwise the order of the shards (case insensitive for the default _ci collations) differs
+     * from the order of the merge and the merged rows are not sorted. */
+    struct sort_column
+    {
+        size_t  index;
+        bool    descending  { false };
+        bool    numeric     { false };
+    };
+
+    /* Streaming k-way merge of several results that are sorted by the same columns.
+     * Only the current row of each stream is held in memory. As soon as the limit is
+     * reached the remaining streams are cancelled. */
+    struct merge_result
+    {
+    public:
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    private:
+        struct stream
+        {
+            connection_ptr  connection;
+            result_used*    result;
+            row*            current;
+        };
+
+        std::vector<stream>         _streams;
+        std::vector<size_t>         _heap;
+        std::vector<sort_column>    _order;
+        size_t                      _limit;
+        size_t                      _count;
+        size_t                      _last;
+        row*                        _row;
+
+        int  compare(const row& a, const row& b) const;
+        bool less   (size_t a, size_t b) const;
+        void push   (size_t i);
+
+    public:
+               void     add     (connection_ptr con, result_used* res);
+               row*     next    ();
+        inline row*     current () const;
+        inline size_t   count   () const;
+               void     cancel  ();
+
+        inline merge_result(std::vector<sort_column> order, size_t limit = npos);
+        merge_result(merge_result&& other) = default;
+               ~merge_result();
+    };
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/connection.h>
+
+namespace cppmariadb
+{
+
+    /* user (tenant) a pooled connection is switched to by mysql_change_user */
+    struct credentials
+    {
+        std::string user;
+        std::string password;
+        std::string database;
+    };
+
+    /* Thread safe pool of connections. Connections are created on demand by the factory
+     * until the maximum size is reached and are returned to the pool as soon as the last
+     * connection_ptr referencing them is released. Connections that were closed in the
+     * meantime are dropped. All connections must be returned before the pool is destroyed.
+     * If reset is enabled returned connections are cleaned up by mysql_reset_connection, so
+     * no session state leaks from one borrower to the next. The keepalive thread pings idle
+     * connections in the background and drops connections that failed the ping or are
+     * idle for longer than max_idle (e.g. close to wait_timeout), so checkout never has to
+     * validate a connection. Dropped connections are replaced by the next checkout. */
+    struct pool
+    {
+    public:
+        using factory_type = std::function<connection()>;
+        using clock_type   = std::chrono::steady_clock;
+        using time_point   = clock_type::time_point;
+        using duration     = clock_type::duration;
+
+    private:
+        using connection_ptru_type = std::unique_ptr<connection>;
+
+        factory_type                        _factory;
+        size_t                              _size;
+        size_t                              _count;
+        bool                                _reset;
+        struct idle_entry
+        {
+            connection_ptru_type    con;
+            time_point              since;
+        };
+
+        std::deque<idle_entry>              _idle;
+        duration                            _ping_interval;
+        duration                            _max_idle;
+        bool                                _running;
+        std::thread                         _keepalive;
+        std::condition_variable             _keepalive_cond;
+        mutable std::mutex                  _mutex;
+        std::condition_variable             _cond;
+
+               void             release (connection* c);
+               connection_ptr   take    (time_point deadline, const credentials* c);
+               void             run     ();
+
+    public:
+               connection_ptr   acquire ();
+               connection_ptr   acquire (time_point deadline);
+               connection_ptr   acquire (const credentials& c, time_point deadline = time_point::max());
+        inline size_t           size    () const;
+        inline size_t           count   () const;
+        inline size_t           idle    () const;
+        inline bool             reset   () const;
+        inline void             reset   (bool value);
+
+        /* pings the connections idle for at least ping_interval, drops the connections that
+         * failed the ping or are idle for longer than max_idle (zero disables the limit) */
+               void             maintain    ();
+               void             keepalive   (duration ping_interval, duration max_idle = duration::zero());
+
+        inline pool(factory_type factory, size_t size);
+               ~pool();
+
+    private:
+        pool(const pool&) = delete;
+    };
+
+}
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
 #include <cppmariadb/config.h>
 #include <cppmariadb/impl/mariadb_handle.h>
 #include <cppmariadb/forward/column.h>
-#include <cppmariadb/forward/row.h>
+#include <cppmariadb/row.h>
 
 namespace cppmariadb
 {
@@ -13,19 +16,31 @@ namespace cppmariadb
         public __impl::mariadb_handle<MYSQL_RES*>
     {
     private:
+        using columns_ptr_type = std::shared_ptr<const column_vector>;
+        using name_index_type  = std::unordered_map<std::string_view, size_t>;
+
+        friend struct connection;
+
         bool                    _is_initialized;
-        std::unique_ptr<row>    _row;
+        mutable row             _row;
         mutable column_vector   _columns;
+        columns_ptr_type        _shared_columns;    // metadata shared through a column_cache
+        mutable name_index_type _names;             // column index by name (and original name)
         unsigned long long      _rowindex;
 
         void update_columns() const;
+        void update_names  () const;
 
     protected:
         inline void rowindex(unsigned long long value);
 
     public:
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
         inline unsigned int         columncount () const;
         inline const column_vector& columns     () const;
+        inline size_t               find        (std::string_view name) const;
+               column_handle        column      (std::string_view name) const;
                row*                 next        ();
         inline row*                 current     () const;
         inline unsigned long long   rowindex    () const;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cppmariadb/config.h>
+#include <cppmariadb/enums.h>
+#include <cppmariadb/balancer.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/router.h>
+#include <cppmariadb/forward/statement.h>
+#include <cppmariadb/forward/transaction.h>
+
+namespace cppmariadb
+{
+
+    /* Splits reads and writes between a primary pool and a set of replica pools. */
+    struct router
+    {
+    public:
+        using clock_type    = std::chrono::steady_clock;
+        using duration_type = clock_type::duration;
+
+        /* Routing state of one logical client. Reads inside a transaction and reads that
+         * follow a write of the same session within the configured window stay on the
+         * primary, so the session always sees its own writes. */
+        struct session
+        {
+        private:
+            using transaction_ptru_type = std::unique_ptr<transaction>;
+
+            router&                 _router;
+            clock_type::time_point  _last_write;
+            connection_ptr          _primary;
+            transaction_ptru_type   _transaction;
+
+        public:
+            inline connection_ptr   acquire         (const statement& s);
+                   connection_ptr   acquire         (query_type type);
+                   void             begin           ();
+                   void             commit          ();
+                   void             rollback        ();
+            inline bool             in_transaction  () const;
+
+            inline session(router& r);
+                   ~session();
+        };
+
+    private:
+        using balancer_t = ::cppmariadb::balancer;
+
+        pool&                   _primary;
+        balancer_t              _balancer;
+        duration_type           _window;
+
+    public:
+               connection_ptr       acquire_primary ();
+               connection_ptr       acquire_replica ();
+        inline pool&                primary         () const;
+        inline balancer_t&          balancer        ();
+        inline duration_type        window          () const;
+
+        inline router(pool& primary, const std::vector<pool*>& replicas, duration_type window);
+    };
+
+}
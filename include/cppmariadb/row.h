@@ -2,7 +2,8 @@
 
 #include <string>
 #include <limits>
-#include <memory>
+#include <string_view>
+#include <type_traits>
 #include <cppmariadb/config.h>
 #include <cppmariadb/impl/mariadb_handle.h>
 #include <cppmariadb/forward/column.h>
@@ -37,17 +38,16 @@ namespace cppmariadb
                 mismatch    =  2
             };
 
-            using value_ptru_type = std::unique_ptr<value_type>;
+            using field_type = typename std::remove_const<T>::type;
 
         private:
             const row*              _owner;
             ssize_t                 _index;
             ssize_t                 _direction;
-            mutable value_ptru_type _cache;
+            mutable field_type      _field;
 
             inline compare_result   compare (const this_type& other) const;
             inline reference        field   () const;
-            inline void             assign  (const this_type& other);
             inline void             next    (difference_type i = 1);
             inline void             prev    (difference_type i = 1);
 
@@ -72,7 +72,6 @@ namespace cppmariadb
             inline this_type        operator [] (difference_type diff);
 
             inline iterator_tpl(const row& p_row, ssize_t index, ssize_t direction);
-            inline iterator_tpl(const this_type& other);
         };
 
     public:
@@ -85,9 +84,16 @@ namespace cppmariadb
         const result&           _result;
         mutable unsigned long*  _lengths;
 
+        friend struct result;
+
+        inline void             bind        (MYSQL_ROW p_row, unsigned long* p_lengths);
+               unsigned long*   fetch_lengths() const;
+        inline field            make_field  (size_t i) const;
+
     public:
         inline const column_vector& columns () const;
         inline unsigned int         size    () const;
+        inline unsigned long*       lengths () const;
         inline iterator_type        begin   () const;
         inline iterator_type        end     () const;
         inline const_iterator_type  cbegin  () const;
@@ -96,13 +102,15 @@ namespace cppmariadb
         inline iterator_type        rend    () const;
         inline const_iterator_type  crbegin () const;
         inline const_iterator_type  crend   () const;
-               size_t               find    (const std::string& name) const;
+        inline size_t               find    (std::string_view name) const;
                field                at      (size_t i) const;
-               field                at      (const std::string name) const;
+               field                at      (std::string_view name) const;
+        inline field                at      (column_handle h) const;
         inline field        operator[]      (size_t i) const;
-        inline field        operator[]      (const std::string& name) const;
+        inline field        operator[]      (std::string_view name) const;
+        inline field        operator[]      (column_handle h) const;
 
-        inline row(const result& p_result, MYSQL_ROW p_row);
+        inline row(const result& p_result, MYSQL_ROW p_row, unsigned long* p_lengths = nullptr);
     };
 
 }
\ No newline at end of file
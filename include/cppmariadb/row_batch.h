@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/result.h>
+#include <cppmariadb/forward/row_batch.h>
+
+namespace cppmariadb
+{
+
+    /* one bit per row of a batch, set if the field of the row is NULL */
+    struct null_bitmap
+    {
+        std::vector<uint64_t> words;
+
+        inline bool     test    (size_t i) const;
+        inline void     set     (size_t i);
+        inline void     reset   (size_t size);
+        inline size_t   count   () const;
+    };
+
+    /* instruction set of the kernels used by row_batch::parse() */
+    enum class simd_level
+    {
+        Scalar,
+        Sse41,
+        Avx2,
+    };
+
+    /* Rows of a stored result that are decoded column by column. Integer and decimal text
+     * columns are parsed by SSE4.1 or AVX2 kernels (selected at runtime, with a scalar
+     * fallback) into contiguous vectors. The rows stay valid until the result is freed. */
+    struct row_batch
+    {
+    private:
+        size_t                      _columns;
+        std::vector<MYSQL_ROW>      _rows;
+        std::vector<unsigned long>  _lengths;   // lengths of all fields, row by row
+        simd_level                  _simd;      // kernels used by parse()
+
+    public:
+        /* best level supported by the cpu, used by default */
+        static simd_level detect_simd();
+
+        /* levels the cpu does not support are lowered to the supported one */
+        inline simd_level   simd        () const;
+        inline void         simd        (simd_level value);
+
+        inline size_t       size        () const;
+        inline size_t       columncount () const;
+        inline void         clear       ();
+
+        /* appends up to max_rows rows of the result, returns the number of rows appended */
+               size_t       fetch       (result_stored& res, size_t max_rows);
+
+        /* fields that are NULL are stored as zero */
+               void         parse       (size_t column, std::vector<int64_t>& values, null_bitmap& nulls) const;
+               void         parse       (size_t column, std::vector<double>&  values, null_bitmap& nulls) const;
+
+        inline row_batch();
+    };
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <condition_variable>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/scheduler.h>
+
+namespace cppmariadb
+{
+
+    /* Priority aware checkout of the connections of a shared pool. Class 0 is the highest
+     * priority. Free connections are handed to the waiting classes by weighted fair queuing,
+     * the last reserved connections are kept for class 0 only, and waiters that waited longer
+     * than the aging interval are served first regardless of their class. All users of the
+     * pool must acquire their connections through the scheduler. */
+    struct scheduler
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+        using time_point = clock_type::time_point;
+        using duration   = std::chrono::microseconds;
+
+        struct statistics
+        {
+            size_t      served      { 0 };
+            size_t      waiting     { 0 };
+            size_t      inflight    { 0 };
+            duration    total_wait  { 0 };
+            duration    max_wait    { 0 };
+        };
+
+    private:
+        struct waiter
+        {
+            size_t                  cls;
+            time_point              enqueued;
+            double                  finish;         // virtual finish time (weighted fair queuing)
+            bool                    granted;
+            std::condition_variable cond;
+        };
+
+        struct queue
+        {
+            double                  weight;
+            double                  finish;         // virtual finish time of the last enqueued waiter
+            std::deque<waiter*>     waiters;
+            statistics              stats;
+        };
+
+        ::cppmariadb::pool&     _pool;
+        size_t                  _capacity;
+        size_t                  _reserved;
+        size_t                  _inflight;
+        double                  _vtime;
+        duration                _aging;
+        std::vector<queue>      _queues;
+        mutable std::mutex      _mutex;
+
+        inline bool allowed (size_t cls) const;
+               void grant   (waiter& w, time_point now);
+               void dispatch();
+               void release (size_t cls);
+
+    public:
+               connection_ptr   acquire (size_t cls, time_point deadline = time_point::max());
+        inline size_t           classes () const;
+        inline statistics       stats   (size_t cls) const;
+        inline void             aging   (duration value);
+
+        /* weights of the priority classes (highest priority first), reserved connections are
+         * only used by class 0, capacity defaults to the size of the pool */
+        inline scheduler(::cppmariadb::pool& p, const std::vector<double>& weights, size_t reserved = 1, size_t capacity = 0);
+
+    private:
+        scheduler(const scheduler&) = delete;
+    };
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <cppmariadb/config.h>
+#include <cppmariadb/forward/row.h>
+#include <cppmariadb/forward/pool.h>
+#include <cppmariadb/forward/column.h>
+#include <cppmariadb/forward/result.h>
+#include <cppmariadb/forward/statement.h>
+#include <cppmariadb/merge_result.h>
+#include <cppmariadb/aggregate_result.h>
+#include <cppmariadb/forward/shard_router.h>
+
+namespace cppmariadb
+{
+
+    /* Concatenation of the results of several connections. The connections are kept
+     * acquired until the result is destroyed. */
+    struct multi_result
+    {
+    private:
+        using entry_type = std::pair<connection_ptr, result_stored*>;
+
+        std::vector<entry_type> _results;
+        size_t                  _index;
+        row*                    _row;
+
+    public:
+        inline void                 add         (connection_ptr con, result_stored* res);
+        inline size_t               size        () const;
+        inline result_stored*       at          (size_t i) const;
+               const column_vector& columns     () const;
+               unsigned long long   rowcount    () const;
+               row*                 next        ();
+        inline row*                 current     () const;
+
+        inline multi_result();
+    };
+
+    /* Maps shard keys to shards by consistent hashing with virtual nodes. */
+    struct shard_router
+    {
+    public:
+        using key_extractor = std::function<std::string (const statement&)>;
+
+    private:
+        struct shard
+        {
+            std::string          name;
+            ::cppmariadb::pool*  pool;
+        };
+
+        using ring_entry = std::pair<uint64_t, size_t>;
+
+        std::vector<shard>      _shards;
+        std::vector<ring_entry> _ring;
+        size_t                  _vnodes;
+        key_extractor           _extractor;
+
+    public:
+        static        uint64_t      hash        (const char* data, size_t size);
+        static inline key_extractor parameter   (const std::string& name);
+
+               void                 add         (const std::string& name, ::cppmariadb::pool& p);
+        inline size_t               size        () const;
+               size_t               shard_for   (const std::string& key) const;
+        inline size_t               shard_for   (const statement& s) const;
+        inline ::cppmariadb::pool&  at          (size_t i) const;
+        inline connection_ptr       acquire     (const std::string& key) const;
+        inline connection_ptr       acquire     (const statement& s) const;
+
+        /* groups the keys by shard and executes the statement once per shard in parallel,
+         * param must name an unescaped parameter (?param!) used as IN list */
+               multi_result         multi_get   (const statement&                s,
+                                                 const std::string&              param,
+                                                 const std::vector<std::string>& keys) const;
+
+        /* executes the statement on all shards in parallel and merges the streamed results
+         * by the passed sort columns, the statement has to sort by the same columns */
+               merge_result         scatter     (const statement&                s,
+                                                 std::vector<sort_column>        order,
+                                                 size_t                          limit = merge_result::npos) const;
+
+        /* executes the GROUP BY statement on all shards in parallel and merges the partial
+         * aggregates of each shard while its rows are streamed in */
+               aggregate_result     aggregate   (const statement&                s,
+                                                 std::vector<size_t>             group_columns,
+                                                 std::vector<aggregate_column>   aggregates) const;
+
+        inline shard_router(key_extractor extractor, size_t vnodes = 160);
+    };
+
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <cppmariadb/config.h>
+#include <cppmariadb/enums.h>
 #include <cppmariadb/forward/connection.h>
 #include <cppmariadb/forward/statement.h>
 
@@ -24,11 +25,14 @@ namespace cppmariadb
 
     private:
         mutable bool                _changed;
+        mutable query_type          _type;
         mutable std::string         _query;
         mutable const connection*   _connection;
 
+        std::string                                     _template;
         std::vector<std::string>                        _code;
         std::vector<std::pair<std::string, parameter>>  _parameters;
+        query_type                                      _hint;
 
         void parse(const std::string& query);
         void build(const connection& con) const;
@@ -36,9 +40,14 @@ namespace cppmariadb
     public:
         inline void                 assign  (const std::string& query);
         inline const std::string&   query   (const connection& con) const;
-        inline size_t               find    (const std::string& param);
+        inline const std::string&   code    () const;
+        inline size_t               find    (const std::string& param) const;
+        inline const std::string&   value   (const std::string& param) const;
+        inline const std::string&   value   (size_t index) const;
         inline void                 set_null(const std::string& param);
         inline void                 set_null(size_t index);
+        inline query_type           type    () const;
+        inline void                 type    (query_type hint);
         inline bool                 empty   () const;
         inline void                 clear   ();
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cppmariadb/config.h>
 #include <cppmariadb/enums.h>
 #include <cppmariadb/forward/connection.h>
@@ -12,16 +13,21 @@ namespace cppmariadb
     struct transaction
     {
     private:
+        using time_point = std::chrono::steady_clock::time_point;
+
         connection&     _connection;
         bool            _closed;
+        time_point      _previous;      // deadline of the connection before the transaction was started
 
         inline void begin();
+        inline void close();
 
     public:
         inline void commit();
         inline void rollback();
 
         inline transaction(connection& connection);
+        inline transaction(connection& connection, time_point deadline);
         inline ~transaction();
     };
 
@@ -0,0 +1,224 @@
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+#include <cppmariadb/row.h>
+#include <cppmariadb/field.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/aggregate_result.h>
+
+#include <cppmariadb/inline/row.inl>
+#include <cppmariadb/inline/field.inl>
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/datetime.inl>
+#include <cppmariadb/inline/aggregate_result.inl>
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    enum class value_kind
+    {
+        exact,      /* integer and DECIMAL columns */
+        floating,   /* FLOAT and DOUBLE columns */
+        time,       /* TIME columns, may be negative or have more than two hour digits */
+        bytes,      /* everything else, compared byte by byte (dates and datetimes are fixed width) */
+    };
+
+    inline value_kind get_kind(const field& f)
+    {
+        switch (f.column().type)
+        {
+            case column_type::Decimal:
+            case column_type::NewDecimal:
+            case column_type::Tiny:
+            case column_type::Short:
+            case column_type::Long:
+            case column_type::Longlong:
+            case column_type::Int24:
+            case column_type::Year:
+                return value_kind::exact;
+            case column_type::Float:
+            case column_type::Double:
+                return value_kind::floating;
+            case column_type::Time:
+            case column_type::Time2:
+                return value_kind::time;
+            default:
+                return value_kind::bytes;
+        }
+    }
+
+    inline decimal parse_exact(const char* c, size_t s)
+    {
+        decimal ret;
+        if (!decimal::parse(c, s, decimal::auto_scale, ret))
+            throw exception("unable to convert field data to an exact number: '" + std::string(c, s) + "'", error_code::UnknownError);
+        return ret;
+    }
+
+    /* returns false if the value overflows */
+    inline bool rescale(decimal& d, unsigned scale)
+    {
+        auto limit = std::numeric_limits<decimal::value_type>::max() / 10;
+        for (; d.scale < scale; ++d.scale)
+        {
+            if (d.unscaled > limit || d.unscaled < -limit)
+                return false;
+            d.unscaled *= 10;
+        }
+        return true;
+    }
+
+    inline void add(decimal& sum, decimal d)
+    {
+        using limits = std::numeric_limits<decimal::value_type>;
+        if (!rescale(sum, d.scale) || !rescale(d, sum.scale)
+            || (d.unscaled > 0 && sum.unscaled > limits::max() - d.unscaled)
+            || (d.unscaled < 0 && sum.unscaled < limits::min() - d.unscaled))
+            throw exception("exact sum out of range", error_code::UnknownError);
+        sum.unscaled += d.unscaled;
+    }
+
+    inline void accumulate(aggregate_value& v, const field& f)
+    {
+        if (get_kind(f) == value_kind::floating)
+        {
+            if (v.is_exact)
+            {
+                v.value    = v.exact.to_double();
+                v.is_exact = false;
+            }
+            v.value += std::strtod(f.data(), nullptr);
+            return;
+        }
+
+        auto d = parse_exact(f.data(), f.size());
+        if (v.is_exact)
+            add(v.exact, d);
+        else if (v.value != 0.0)
+            v.value += d.to_double();
+        else
+        {
+            v.exact    = d;
+            v.is_exact = true;
+        }
+    }
+
+    /* compares the field data with the current minimum or maximum */
+    inline int compare(const field& f, const std::string& text)
+    {
+        switch (get_kind(f))
+        {
+            case value_kind::exact:
+                return decimal::compare(parse_exact(f.data(), f.size()), parse_exact(text.data(), text.size()));
+
+            case value_kind::floating:
+            {
+                auto a = std::strtod(f.data(), nullptr);
+                auto b = std::strtod(text.c_str(), nullptr);
+                return a < b ? -1 : (a > b ? 1 : 0);
+            }
+
+            case value_kind::time:
+            {
+                std::chrono::microseconds a, b;
+                if (__impl::parse_time(f.data(), f.size(), a) && __impl::parse_time(text.data(), text.size(), b))
+                    return a < b ? -1 : (a > b ? 1 : 0);
+                break;
+            }
+
+            default:
+                break;
+        }
+        return std::string_view(f.data(), f.size()).compare(text);
+    }
+
+}
+
+void aggregate_result::merge(const row& r)
+{
+    /* build the group key: length prefixed values, NULL is encoded as a single '\0' */
+    _key.clear();
+    for (auto i : _group_columns)
+    {
+        auto f = r.at(i);
+        if (f.is_null())
+        {
+            _key.push_back('\0');
+            continue;
+        }
+        _key.push_back('\1');
+        auto size = f.size();
+        _key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        _key.append(f.data(), f.size());
+    }
+
+    auto it = _groups.find(_key);
+    if (it == _groups.end())
+    {
+        group g;
+        g.keys.reserve(_group_columns.size());
+        g.nulls.reserve(_group_columns.size());
+        for (auto i : _group_columns)
+        {
+            auto f = r.at(i);
+            g.nulls.emplace_back(f.is_null());
+            g.keys.emplace_back(f.is_null() ? std::string() : std::string(f.data(), f.size()));
+        }
+        g.values.reserve(_aggregates.size());
+        for (auto& a : _aggregates)
+            g.values.emplace_back(aggregate_value { a.function });
+        it = _groups.emplace(_key, std::move(g)).first;
+    }
+
+    auto& values = it->second.values;
+    for (size_t i = 0; i < _aggregates.size(); ++i)
+    {
+        auto& a = _aggregates.at(i);
+        auto& v = values.at(i);
+        auto  f = r.at(a.index);
+
+        /* field data is always terminated by the client library */
+        switch (a.function)
+        {
+            case aggregate_function::Count:
+                v.is_null = false;
+                if (!f.is_null())
+                    v.count += std::strtoll(f.data(), nullptr, 10);
+                break;
+
+            case aggregate_function::Sum:
+                if (f.is_null())
+                    break;
+                accumulate(v, f);
+                v.is_null = false;
+                break;
+
+            case aggregate_function::Min:
+            case aggregate_function::Max:
+            {
+                if (f.is_null())
+                    break;
+                auto c = v.is_null ? 0 : compare(f, v.text);
+                if (v.is_null || (a.function == aggregate_function::Min ? c < 0 : c > 0))
+                    v.text.assign(f.data(), f.size());
+                v.is_null = false;
+                break;
+            }
+
+            case aggregate_function::Avg:
+            {
+                auto c = r.at(a.count_index);
+                if (!c.is_null())
+                    v.count += std::strtoll(c.data(), nullptr, 10);
+                if (!f.is_null())
+                    accumulate(v, f);
+                v.is_null = (v.count == 0);
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include <random>
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/pool.h>
+#include <cppmariadb/field.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/balancer.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/row.inl>
+#include <cppmariadb/inline/pool.inl>
+#include <cppmariadb/inline/field.inl>
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/balancer.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+void balancer::record(backend& b, clock_type::duration d)
+{
+    auto sample = std::chrono::duration<double, std::micro>(d).count();
+    auto value  = b.latency.load(std::memory_order_relaxed);
+    double next;
+    do
+    {
+        next = (value == 0.0)
+            ? sample
+            : value + _decay * (sample - value);
+    }
+    while (!b.latency.compare_exchange_weak(value, next, std::memory_order_relaxed));
+}
+
+connection_ptr balancer::acquire(size_t exclude, size_t* index)
+{
+    thread_local std::minstd_rand rnd(std::random_device { }());
+
+    std::vector<backend*> candidates;
+    candidates.reserve(_backends.size());
+    for (size_t i = 0; i < _backends.size(); ++i)
+    {
+        auto& b = _backends.at(i);
+        if (!b->ejected.load(std::memory_order_relaxed) && i != exclude)
+            candidates.emplace_back(b.get());
+    }
+    if (candidates.empty())
+        return connection_ptr();
+
+    backend* b = candidates.front();
+    if (candidates.size() > 1)
+    {
+        std::uniform_int_distribution<size_t> dist(0, candidates.size() - 1);
+        auto i = dist(rnd);
+        auto j = dist(rnd);
+        if (i == j)
+            j = (j + 1) % candidates.size();
+        b = (score(*candidates.at(i)) <= score(*candidates.at(j)))
+            ? candidates.at(i)
+            : candidates.at(j);
+    }
+
+    if (index)
+    {
+        *index = static_cast<size_t>(std::find_if(_backends.begin(), _backends.end(), [b](const backend_ptru_type& p){
+            return p.get() == b;
+        }) - _backends.begin());
+    }
+
+    b->inflight.fetch_add(1, std::memory_order_relaxed);
+    connection_ptr con;
+    try
+    {
+        con = b->replica.acquire();
+    }
+    catch(...)
+    {
+        b->inflight.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    /* only the round trips of the queries are recorded, neither the pool wait nor the time
+     * the caller holds the connection */
+    auto ptr  = con.get();
+    auto prev = ptr->observer();
+    ptr->observer([this, b, prev](clock_type::duration d) {
+        record(*b, d);
+        if (prev)
+            prev(d);
+    });
+    return connection_ptr(ptr, [b, prev = std::move(prev), con = std::move(con)](connection* c) mutable {
+        c->observer(std::move(prev));
+        b->inflight.fetch_sub(1, std::memory_order_relaxed);
+        con.reset();
+    });
+}
+
+void balancer::probe()
+{
+    static const std::string query("SHOW SLAVE STATUS");
+
+    for (auto& b : _backends)
+    {
+        long long lag = 0;
+        try
+        {
+            auto con = b->replica.acquire();
+            auto res = con->execute_stored(query);
+            row* r = (res ? res->next() : nullptr);
+            while (r)
+            {
+                /* Seconds_Behind_Master is NULL if the replication is not running */
+                auto f = r->at("Seconds_Behind_Master");
+                if (f.is_null())
+                {
+                    lag = lag_unknown;
+                    break;
+                }
+                lag = std::max(lag, f.get<long long>());
+                r = res->next();
+            }
+        }
+        catch(const exception&)
+        {
+            lag = lag_unknown;
+        }
+
+        b->lag.store(lag);
+        if (lag == lag_unknown || lag > _max_lag.count())
+            b->ejected.store(true);
+        else if (lag <= _restore_lag.count())
+            b->ejected.store(false);
+    }
+}
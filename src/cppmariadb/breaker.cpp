@@ -0,0 +1,97 @@
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/breaker.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/breaker.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+void breaker::admit()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_state == state_t::Closed)
+        return;
+    if (    _state == state_t::HalfOpen
+        ||  clock_type::now() - _opened < _cooldown)
+        throw circuit_open_exception("circuit breaker is open", error_code::Unknown);
+    _state = state_t::HalfOpen;
+    auto probe = _probe;
+    lock.unlock();
+
+    /* only the request that switched to half open executes the probe, all others are rejected */
+    bool success = true;
+    connection_ptr con;
+    try
+    {
+        con = _pool.acquire();
+        con->execute(probe);
+    }
+    catch(...)
+    {
+        if (con)
+            con->close();
+        success = false;
+    }
+    con.reset();
+
+    lock.lock();
+    if (!success)
+    {
+        _state  = state_t::Open;
+        _opened = clock_type::now();
+        throw circuit_open_exception("circuit breaker is open (probe failed)", error_code::Unknown, probe);
+    }
+    _state = state_t::Closed;
+    for (auto& b : _buckets)
+        b = bucket();
+}
+
+void breaker::record(error_class_t c)
+{
+    auto now  = clock_type::now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_buckets.empty())
+        return;
+
+    auto slot  = std::chrono::duration_cast<duration>(now.time_since_epoch()) / _bucket_width;
+    auto start = clock_type::time_point(std::chrono::duration_cast<clock_type::duration>(slot * _bucket_width));
+    auto& b    = _buckets.at(static_cast<size_t>(slot) % _buckets.size());
+    if (b.start != start)
+    {
+        b       = bucket();
+        b.start = start;
+    }
+    ++b.total;
+    if (c == error_class_t::Connection)
+        ++b.connection;
+    else if (c == error_class_t::Query)
+        ++b.query;
+
+    if (    _state != state_t::Closed
+        ||  c      == error_class_t::None)
+        return;
+
+    size_t total       = 0;
+    size_t connections = 0;
+    size_t queries     = 0;
+    auto oldest = start - _bucket_width * static_cast<long>(_buckets.size() - 1);
+    for (auto& x : _buckets)
+    {
+        if (x.start < oldest)
+            continue;
+        total       += x.total;
+        connections += x.connection;
+        queries     += x.query;
+    }
+    if (total < _min_requests || total == 0)
+        return;
+    if (    static_cast<double>(connections) >= _connection_threshold * static_cast<double>(total)
+        ||  static_cast<double>(queries)     >= _query_threshold      * static_cast<double>(total))
+    {
+        _state  = state_t::Open;
+        _opened = now;
+    }
+}
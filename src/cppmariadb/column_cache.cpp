@@ -0,0 +1,114 @@
+#include <cppmariadb/column.h>
+#include <cppmariadb/column_cache.h>
+
+#include <cppmariadb/inline/column_cache.inl>
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    struct interned_columns
+    {
+        std::string     names;
+        column_vector   columns;
+    };
+
+    inline std::string_view append(std::string& names, const char* data, size_t size)
+    {
+        auto offset = names.size();
+        names.append(data, size);
+        return std::string_view(names.data() + offset, size);
+    }
+
+    inline bool equals(const std::string_view& s, const char* data, size_t size)
+        { return s == std::string_view(data, size); }
+
+}
+
+column_cache::columns_ptr_type column_cache::intern(const MYSQL_FIELD* fields, size_t count)
+{
+    auto ret  = std::make_shared<interned_columns>();
+    auto size = size_t(0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& f = fields[i];
+        size += f.name_length + f.org_name_length + f.table_length + f.org_table_length + f.db_length;
+    }
+
+    /* all names share one buffer that is never reallocated after the views were taken */
+    ret->names.reserve(size);
+    ret->columns.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& f = fields[i];
+        ret->columns.emplace_back(f);
+        auto& c = ret->columns.back();
+        c.name           = append(ret->names, f.name,      f.name_length);
+        c.original_name  = append(ret->names, f.org_name,  f.org_name_length);
+        c.table          = append(ret->names, f.table,     f.table_length);
+        c.original_table = append(ret->names, f.org_table, f.org_table_length);
+        c.database       = append(ret->names, f.db,        f.db_length);
+        c.max_length     = 0;
+    }
+    return columns_ptr_type(ret, &ret->columns);
+}
+
+bool column_cache::matches(const column_vector& columns, const MYSQL_FIELD* fields, size_t count)
+{
+    if (columns.size() != count)
+        return false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& c = columns[i];
+        auto& f = fields[i];
+        auto same = c.type           == static_cast<column_type>(f.type)
+                 && c.length         == f.length
+                 && c.decimals       == f.decimals
+                 && c.charset_number == f.charsetnr
+                 && c.flags          == column_flags(f.flags)
+                 && equals(c.name,          f.name,     f.name_length)
+                 && equals(c.original_name, f.org_name, f.org_name_length)
+                 && equals(c.table,         f.table,    f.table_length);
+        if (!same)
+            return false;
+    }
+    return true;
+}
+
+column_cache::columns_ptr_type column_cache::lookup(const std::string& query, MYSQL_RES* res)
+{
+    auto fields = mysql_fetch_fields(res);
+    auto count  = mysql_num_fields  (res);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(query);
+        if (it != _entries.end() && matches(*it->second.columns, fields, count))
+        {
+            _lru.splice(_lru.begin(), _lru, it->second.position);
+            return it->second.columns;
+        }
+    }
+
+    auto ret = intern(fields, count);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(query);
+    if (it != _entries.end())
+    {
+        it->second.columns = ret;
+        _lru.splice(_lru.begin(), _lru, it->second.position);
+        return ret;
+    }
+    if (_capacity == 0)
+        return ret;
+    if (_entries.size() >= _capacity)
+    {
+        _entries.erase(_lru.back());
+        _lru.pop_back();
+    }
+    _lru.emplace_front(query);
+    _entries.emplace(query, entry { ret, _lru.begin() });
+    return ret;
+}
@@ -0,0 +1,504 @@
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/connection.h>
+#include <cppmariadb/exception.h>
+
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    inline std::string normalize(const char* b, const char* e)
+    {
+        while (b < e && std::isspace(static_cast<unsigned char>(*b)))
+            ++b;
+        while (e > b && std::isspace(static_cast<unsigned char>(*(e-1))))
+            --e;
+        std::string ret;
+        ret.reserve(static_cast<size_t>(e - b));
+        bool space = false;
+        for (; b < e; ++b)
+        {
+            auto c = static_cast<unsigned char>(*b);
+            if (std::isspace(c))
+            {
+                space = true;
+                continue;
+            }
+            if (space)
+                ret.push_back(' ');
+            ret.push_back(static_cast<char>(std::toupper(c)));
+            space = false;
+        }
+        return ret;
+    }
+
+    /* returns the part of a session statement that identifies the changed state
+     * (e.g. "SET TIME_ZONE" for "SET time_zone = '+00:00'") or an empty string if
+     * the statement does not only change the state of the current session */
+    inline std::string session_key(const std::string& cmd)
+    {
+        static const char* ignored[] =
+            { "SET GLOBAL ", "SET @@GLOBAL.", "SET TRANSACTION ", "SET STATEMENT ", "SET PASSWORD", "SET DEFAULT ROLE " };
+
+        auto b = cmd.c_str();
+        auto e = b + cmd.size();
+        auto n = normalize(b, e);
+        for (auto i : ignored)
+        {
+            if (n.compare(0, std::strlen(i), i) == 0)
+                return std::string();
+        }
+        if (n.compare(0, 4, "USE ") == 0)
+            return "USE";
+        if (n.compare(0, 4, "SET ") != 0)
+            return std::string();
+
+        /* statements that change more than one variable are kept as they are */
+        if (std::find(b, e, ',') != e)
+            return n;
+        auto p = std::find(b, e, '=');
+        if (p != e)
+            return normalize(b, p);
+
+        /* SET NAMES ..., SET CHARACTER SET ..., SET ROLE ... */
+        auto s = n.find(' ', 4);
+        if (n.compare(4, 10, "CHARACTER ") == 0)
+            s = n.find(' ', s + 1);
+        return n.substr(0, s);
+    }
+
+    inline std::string trim(const std::string& s)
+    {
+        size_t b = 0;
+        size_t e = s.size();
+        while (b < e && (std::isspace(static_cast<unsigned char>(s[b]))))
+            ++b;
+        while (e > b && (std::isspace(static_cast<unsigned char>(s[e-1])) || s[e-1] == ';'))
+            --e;
+        return s.substr(b, e - b);
+    }
+
+    inline std::string lower(std::string s)
+    {
+        for (auto& c : s)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return s;
+    }
+
+    inline std::string unquote(const std::string& s)
+    {
+        auto ret = trim(s);
+        if (    ret.size() >= 2
+            && (ret.front() == '\'' || ret.front() == '"' || ret.front() == '`')
+            &&  ret.back() == ret.front())
+            ret = ret.substr(1, ret.size() - 2);
+        return ret;
+    }
+
+    inline bool starts_with(const std::string& s, const char* prefix)
+        { return s.compare(0, std::strlen(prefix), prefix) == 0; }
+
+    /* state of the transaction after the transaction control statement cmd was executed */
+    inline bool transaction_open(const std::string& cmd, bool open)
+    {
+        auto n = normalize(cmd.data(), cmd.data() + cmd.size());
+        while (!n.empty() && (n.back() == ';' || n.back() == ' '))
+            n.pop_back();
+        if (    starts_with(n, "START TRANSACTION")
+            ||  starts_with(n, "BEGIN WORK")
+            ||  starts_with(n, "XA START")
+            ||  starts_with(n, "XA BEGIN")
+            ||  n == "BEGIN")
+            return true;
+        if (    starts_with(n, "XA COMMIT")
+            ||  starts_with(n, "XA ROLLBACK"))
+            return false;
+        if (    starts_with(n, "ROLLBACK TO ")
+            ||  starts_with(n, "ROLLBACK WORK TO "))
+            return open;
+        if (    starts_with(n, "COMMIT")
+            ||  starts_with(n, "ROLLBACK"))
+            return (n.find(" AND CHAIN") != std::string::npos);
+        return open;
+    }
+
+    /* splits the list of a SET statement at the commas outside of quotes and parentheses */
+    inline std::vector<std::string> split_list(const std::string& s)
+    {
+        std::vector<std::string> ret;
+        size_t begin = 0;
+        size_t depth = 0;
+        char   quote = 0;
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            auto c = s[i];
+            if (quote)
+            {
+                if (c == '\\')
+                    ++i;
+                else if (c == quote)
+                    quote = 0;
+            }
+            else if (c == '\'' || c == '"' || c == '`')
+                quote = c;
+            else if (c == '(')
+                ++depth;
+            else if (c == ')' && depth > 0)
+                --depth;
+            else if (c == ',' && depth == 0)
+            {
+                ret.emplace_back(s.substr(begin, i - begin));
+                begin = i + 1;
+            }
+        }
+        ret.emplace_back(s.substr(begin));
+        return ret;
+    }
+
+    /* updates the session state by the variables changed by a SET or USE statement */
+    inline void parse_session(const std::string& cmd, connection::session_state_type& state)
+    {
+        auto t = trim(cmd);
+        auto l = lower(t);
+        if (starts_with(l, "use ") || starts_with(l, "use\t"))
+        {
+            state["schema"] = unquote(t.substr(4));
+            return;
+        }
+        if (!starts_with(l, "set ") && !starts_with(l, "set\t"))
+            return;
+        if (session_key(cmd).empty())
+            return;
+
+        for (auto& item : split_list(t.substr(4)))
+        {
+            auto v  = trim(item);
+            auto lv = lower(v);
+            for (auto prefix : { "session ", "local ", "@@session.", "@@local.", "@@" })
+            {
+                if (starts_with(lv, prefix))
+                {
+                    v  = trim(v.substr(std::strlen(prefix)));
+                    lv = lower(v);
+                    break;
+                }
+            }
+            if (starts_with(lv, "global ") || starts_with(lv, "@"))
+                continue;
+
+            for (auto prefix : { "names ", "character set ", "charset " })
+            {
+                if (starts_with(lv, prefix))
+                {
+                    auto value = trim(v.substr(std::strlen(prefix)));
+                    auto end   = value.find_first_of(" \t");
+                    state["names"] = unquote(value.substr(0, end));
+                    lv.clear();
+                    break;
+                }
+            }
+
+            auto pos = v.find('=');
+            if (lv.empty() || pos == std::string::npos)
+                continue;
+            auto name = trim(v.substr(0, pos));
+            if (!name.empty() && name.back() == ':')
+                name.pop_back();
+            state[lower(trim(name))] = unquote(v.substr(pos + 1));
+        }
+    }
+
+    inline bool equals(const std::string& a, const std::string& b)
+    {
+        return a.size() == b.size()
+            && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y){
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+    }
+
+    /* position right behind the leading SELECT keyword or npos */
+    inline size_t select_end(const std::string& cmd)
+    {
+        size_t i = 0;
+        while (i < cmd.size() && (std::isspace(static_cast<unsigned char>(cmd[i])) || cmd[i] == '('))
+            ++i;
+        static const char keyword[] = "SELECT";
+        for (auto k : keyword)
+        {
+            if (!k)
+                break;
+            if (i >= cmd.size() || std::toupper(static_cast<unsigned char>(cmd[i])) != k)
+                return std::string::npos;
+            ++i;
+        }
+        if (i < cmd.size() && (std::isalnum(static_cast<unsigned char>(cmd[i])) || cmd[i] == '_'))
+            return std::string::npos;
+        return i;
+    }
+
+}
+
+void connection::record_session(const std::string& cmd)
+{
+    if (database::query_type(cmd) != query_type::Session)
+        return;
+    auto key = session_key(cmd);
+    if (key.empty())
+        return;
+    auto it = std::find_if(_session.begin(), _session.end(), [&key](const std::string& s){
+        return session_key(s) == key;
+    });
+    if (it != _session.end())
+        _session.erase(it);
+    _session.emplace_back(cmd);
+}
+
+bool connection::in_transaction() const
+{
+    if (_transaction)
+        return true;
+    auto it = _state.find("autocommit");
+    return it != _state.end()
+        && (    it->second == "0"
+            ||  equals(it->second, "OFF")
+            ||  equals(it->second, "FALSE"));
+}
+
+void connection::track_session(const std::string& cmd)
+{
+    auto type = database::query_type(cmd);
+    if (type == query_type::Transaction)
+        _transaction = transaction_open(cmd, _transaction);
+    if (type == query_type::Session)
+    {
+        parse_session(cmd, _state);
+        if (_auto_reconnect)
+            record_session(cmd);
+    }
+
+    if (!_options || !_options->flags.is_set(client_flag::SessionTracking))
+        return;
+
+    /* the server reports name and value of each changed variable as two separate entries */
+    const char* data;
+    size_t      size;
+    if (mysql_session_track_get_first(handle(), SESSION_TRACK_SYSTEM_VARIABLES, &data, &size) == 0)
+    {
+        do
+        {
+            auto name = lower(std::string(data, size));
+            if (mysql_session_track_get_next(handle(), SESSION_TRACK_SYSTEM_VARIABLES, &data, &size) != 0)
+                break;
+            _state[name] = std::string(data, size);
+        }
+        while (mysql_session_track_get_next(handle(), SESSION_TRACK_SYSTEM_VARIABLES, &data, &size) == 0);
+    }
+    if (mysql_session_track_get_first(handle(), SESSION_TRACK_SCHEMA, &data, &size) == 0)
+        _state["schema"] = std::string(data, size);
+}
+
+void connection::ensure_session(const session_values_type& values)
+{
+    std::string set;
+    std::string schema;
+    for (auto& v : values)
+    {
+        auto name = lower(v.first);
+        auto it   = _state.find(name);
+        if (it != _state.end() && equals(it->second, unquote(v.second)))
+            continue;
+        if (name == "schema")
+        {
+            schema = v.second;
+            continue;
+        }
+        set += (set.empty() ? "SET " : ", ");
+        set += (name == "names" ? "NAMES " : name + "=");
+        set += v.second;
+    }
+    if (    !schema.empty()
+        &&  !set.empty()
+        &&  _options
+        &&  _options->flags.is_set(client_flag::MultiStatements))
+    {
+        execute_batch({ "USE " + schema, set });
+        return;
+    }
+    if (!schema.empty())
+        execute("USE " + schema);
+    if (!set.empty())
+        execute(set);
+}
+
+void connection::execute_batch(const std::vector<std::string>& cmds)
+{
+    std::string cmd;
+    for (auto& c : cmds)
+        cmd += (cmd.empty() ? "" : "; ") + c;
+    if (!handle())
+        throw exception("invalid handle", error_code::Unknown, cmd);
+    database::thread_init();
+    _result.reset();
+
+    /* each statement has its own result, all of them have to be read before the next query */
+    auto start  = clock_type::now();
+    auto status = mysql_real_query(*this, cmd.data(), cmd.size());
+    while (status == 0)
+    {
+        auto res = mysql_store_result(*this);
+        if (res)
+            mysql_free_result(res);
+        else if (mysql_field_count(*this) != 0)
+            break;
+        status = mysql_next_result(*this);
+    }
+    if (_observer)
+        _observer(clock_type::now() - start);
+    if (status >= 0)
+    {
+        auto err = database::error_code(*this);
+        if (    !_auto_reconnect
+            ||  in_transaction()
+            ||  !database::connection_lost(err))
+            throw exception(database::error_msg(*this), err, cmd);
+
+        /* the statements are retried one by one on the new connection */
+        reconnect();
+        for (auto& c : cmds)
+            execute(c);
+        return;
+    }
+
+    for (auto& c : cmds)
+        track_session(c);
+}
+
+void connection::reconnect()
+{
+    if (!_options)
+        throw exception("unable to reconnect: connection parameters are unknown", error_code::Unknown);
+
+    auto tmp = database::connect(*_options);
+    for (auto& cmd : _session)
+    {
+        if (mysql_real_query(tmp, cmd.data(), cmd.size()) != 0)
+            throw exception(database::error_msg(tmp), database::error_code(tmp), cmd);
+        auto res = mysql_store_result(tmp);
+        if (res)
+            mysql_free_result(res);
+    }
+
+    _result.reset();
+    _transaction = false;
+    _state.clear();
+    if (!_options->database.empty())
+        _state["schema"] = _options->database;
+    for (auto& cmd : _session)
+        parse_session(cmd, _state);
+    auto h = handle();
+    handle(tmp.handle());
+    tmp.handle(h);
+}
+
+std::string connection::apply_deadline(const std::string& cmd) const
+{
+    auto now = clock_type::now();
+    if (now >= _deadline)
+        throw timeout_exception("deadline exceeded before the query was sent", error_code::StatementTimeout, cmd);
+
+    auto ms   = std::chrono::ceil<std::chrono::milliseconds>(_deadline - now).count();
+    auto type = database::query_type(cmd);
+    switch (_server_timeout)
+    {
+        case server_timeout_t::MaxStatementTime:
+        {
+            if (    type != query_type::Read
+                &&  type != query_type::Write)
+                break;
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%lld.%03lld", static_cast<long long>(ms / 1000), static_cast<long long>(ms % 1000));
+            return std::string("SET STATEMENT max_statement_time=") + buf + " FOR " + cmd;
+        }
+
+        case server_timeout_t::MaxExecutionTime:
+        {
+            auto pos = select_end(cmd);
+            if (pos == std::string::npos)
+                break;
+            auto ret = cmd;
+            ret.insert(pos, " /*+ MAX_EXECUTION_TIME(" + std::to_string(ms) + ") */");
+            return ret;
+        }
+
+        default:
+            break;
+    }
+    return cmd;
+}
+
+void connection::reset_state()
+{
+    _transaction = false;
+    _deadline    = time_point::max();
+    _session.clear();
+
+    /* the default database is kept by the server */
+    auto it = _state.find("schema");
+    if (it == _state.end())
+    {
+        _state.clear();
+        return;
+    }
+    auto schema = std::move(it->second);
+    _state.clear();
+    _state.emplace("schema", std::move(schema));
+}
+
+void connection::reset()
+{
+    /* a pending result_used reads its remaining rows when it is destroyed */
+    _result.reset();
+    if (!handle())
+        throw exception("invalid handle", error_code::Unknown);
+    if (mysql_reset_connection(handle()) != 0)
+        throw exception(database::error_msg(*this), database::error_code(*this));
+    reset_state();
+}
+
+void connection::change_user(const std::string& user, const std::string& password, const std::string& database)
+{
+    _result.reset();
+    if (!handle())
+        throw exception("invalid handle", error_code::Unknown);
+    if (mysql_change_user(
+            handle(),
+            user.c_str(),
+            password.c_str(),
+            database.empty() ? static_cast<const char*>(nullptr) : database.c_str()))
+        throw exception(database::error_msg(*this), database::error_code(*this));
+    if (_options)
+    {
+        _options->user     = user;
+        _options->password = password;
+        _options->database = database;
+    }
+    reset_state();
+    _state.clear();
+    if (!database.empty())
+        _state["schema"] = database;
+}
+
+bool connection::cancel() const
+{
+    if (!_options || !handle())
+        return false;
+    database::kill_query(*_options, thread_id());
+    return true;
+}
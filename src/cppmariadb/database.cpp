@@ -0,0 +1,102 @@
+#include <cctype>
+#include <cstring>
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/database.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/database.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    struct library_guard
+    {
+        inline library_guard()
+        {
+            if (mysql_library_init(0, nullptr, nullptr) != 0)
+                throw exception("unable to initialize the client library", error_code::Unknown);
+        }
+
+        inline ~library_guard()
+            { mysql_library_end(); }
+    };
+
+    struct thread_guard
+    {
+        inline thread_guard()
+            { mysql_thread_init(); }
+
+        inline ~thread_guard()
+            { mysql_thread_end(); }
+    };
+
+}
+
+void database::thread_init()
+{
+    static library_guard library;
+    thread_local thread_guard thread;
+}
+
+query_type database::query_type(const std::string& cmd)
+{
+    auto c = cmd.c_str();
+    auto e = c + cmd.size();
+
+    /* skip leading whitespaces, comments and parentheses */
+    while (c < e)
+    {
+        if (std::isspace(static_cast<unsigned char>(*c)) || *c == '(')
+            ++c;
+        else if (*c == '#' || (*c == '-' && c + 2 < e && c[1] == '-' && std::isspace(static_cast<unsigned char>(c[2]))))
+        {
+            while (c < e && *c != '\n')
+                ++c;
+        }
+        else if (*c == '/' && c + 1 < e && c[1] == '*')
+        {
+            auto p = std::strstr(c + 2, "*/");
+            c = (p ? p + 2 : e);
+        }
+        else
+            break;
+    }
+
+    /* extract the leading keyword */
+    char keyword[16];
+    size_t len = 0;
+    while (c < e && std::isalpha(static_cast<unsigned char>(*c)) && len < sizeof(keyword) - 1)
+        keyword[len++] = static_cast<char>(std::toupper(static_cast<unsigned char>(*c++)));
+    keyword[len] = '\0';
+    if (len == 0)
+        return query_type_t::Unknown;
+
+    static const char* read_keywords[] =
+        { "SELECT", "SHOW", "DESC", "DESCRIBE", "EXPLAIN", "WITH", "HELP", "VALUES", "TABLE" };
+    static const char* session_keywords[] =
+        { "SET", "USE" };
+    static const char* transaction_keywords[] =
+        { "START", "BEGIN", "COMMIT", "ROLLBACK", "SAVEPOINT", "RELEASE", "XA" };
+
+    for (auto k : read_keywords)
+        if (std::strcmp(k, keyword) == 0)
+            return query_type_t::Read;
+    for (auto k : session_keywords)
+        if (std::strcmp(k, keyword) == 0)
+            return query_type_t::Session;
+    for (auto k : transaction_keywords)
+        if (std::strcmp(k, keyword) == 0)
+            return query_type_t::Transaction;
+    return query_type_t::Write;
+}
+
+void database::kill_query(const connect_options& options, unsigned long thread_id, std::chrono::seconds timeout)
+{
+    auto side = connect(options, timeout);
+    side.execute("KILL QUERY " + std::to_string(thread_id));
+}
@@ -0,0 +1,132 @@
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/executor.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/executor.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+executor::task* executor::pop(worker& w)
+{
+    /* consumer side of the intrusive MPSC queue (Vyukov), only called by the worker itself */
+    auto tail = w.tail;
+    auto next = tail->next.load(std::memory_order_acquire);
+    if (tail == &w.stub)
+    {
+        if (!next)
+            return nullptr;
+        w.tail = next;
+        tail   = next;
+        next   = next->next.load(std::memory_order_acquire);
+    }
+    if (next)
+    {
+        w.tail = next;
+        return tail;
+    }
+    if (tail != w.head.load(std::memory_order_acquire))
+        return nullptr;     // a producer is in the middle of a push
+    push(w, &w.stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        w.tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void executor::enqueue(size_t index, size_t backend, task* t)
+{
+    if (!_running.load())
+        throw exception("executor is stopped", error_code::Unknown);
+    if (backend >= _backends.size())
+        throw exception("invalid backend index", error_code::Unknown);
+    auto& w = *_workers.at(index);
+    t->backend = backend;
+    push(w, t);
+
+    /* pairs with the fence of the worker: either the worker sees the task or we see it sleeping */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (w.sleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(w.mutex);
+        w.sleeping.store(false);
+        w.cond.notify_one();
+    }
+}
+
+void executor::run(worker& w)
+{
+    w.connections.resize(_backends.size());
+    while (true)
+    {
+        auto t = pop(w);
+        if (!t)
+        {
+            std::unique_lock<std::mutex> lock(w.mutex);
+            w.sleeping.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            t = pop(w);
+            if (!t)
+            {
+                if (!_running.load())
+                    break;
+                w.cond.wait(lock, [&w]{
+                    return !w.sleeping.load();
+                });
+                continue;
+            }
+            w.sleeping.store(false);
+        }
+
+        std::unique_ptr<task> ptr(t);
+        try
+        {
+            auto& c = w.connections.at(t->backend);
+            if (!c || !c->handle())
+                c.reset(new connection(_backends.at(t->backend)()));
+            t->run(*c);
+        }
+        catch(...)
+        {
+            t->fail(std::current_exception());
+        }
+    }
+
+    /* the connections are closed by the thread that used them */
+    w.connections.clear();
+}
+
+executor::executor(std::vector<factory_type> backends, size_t workers)
+    : _backends (std::move(backends))
+    , _next     (0)
+    , _running  (true)
+{
+    if (workers == 0)
+        workers = 1;
+    _workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+        _workers.emplace_back(new worker());
+    for (auto& w : _workers)
+        w->thread = std::thread(&executor::run, this, std::ref(*w));
+}
+
+executor::~executor()
+{
+    _running.store(false);
+    for (auto& w : _workers)
+    {
+        std::lock_guard<std::mutex> lock(w->mutex);
+        w->sleeping.store(false);
+        w->cond.notify_one();
+    }
+    for (auto& w : _workers)
+    {
+        if (w->thread.joinable())
+            w->thread.join();
+    }
+}
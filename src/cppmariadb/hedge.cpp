@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cppmariadb/row.h>
+#include <cppmariadb/hedge.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/balancer.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/statement.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/hedge.inl>
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/balancer.inl>
+#include <cppmariadb/inline/statement.inl>
+#include <cppmariadb/inline/connection.inl>
+#include <cppmariadb/inline/shard_router.inl>
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    /* state shared between the caller and the (at most two) replicas executing the read */
+    struct race
+    {
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        std::mutex                  mutex;
+        std::condition_variable     cond;
+        size_t                      winner  { npos };
+        size_t                      done    { 0 };
+        connection_ptr              connections[2];
+        result_stored*              results[2] { nullptr, nullptr };
+        std::exception_ptr          errors[2];
+        hedge::clock_type::time_point starts[2];
+    };
+
+}
+
+void hedge::record(duration d)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_samples.size() < _window)
+        _samples.emplace_back(d);
+    else
+        _samples.at(_next) = d;
+    _next = (_next + 1) % _window;
+
+    /* the quantile is recalculated every few samples only */
+    if (_samples.size() < min_samples || _next % 16 != 0)
+        return;
+    auto tmp = _samples;
+    auto n   = static_cast<size_t>(_quantile * static_cast<double>(tmp.size() - 1));
+    std::nth_element(tmp.begin(), tmp.begin() + static_cast<ptrdiff_t>(n), tmp.end());
+    _delay = tmp.at(n);
+}
+
+bool hedge::acquire()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_tokens < 1.0)
+        return false;
+    _tokens -= 1.0;
+    ++_hedged;
+    return true;
+}
+
+void hedge::refund()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tokens += 1.0;
+    --_hedged;
+}
+
+void hedge::drain(std::future<void> f)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _draining.erase(
+        std::remove_if(_draining.begin(), _draining.end(), [](const std::future<void>& x){
+            return x.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }),
+        _draining.end());
+    _draining.emplace_back(std::move(f));
+}
+
+multi_result hedge::execute_stored(const statement& s)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_reads;
+        _tokens = std::min(max_tokens, _tokens + _budget);
+    }
+
+    auto r = std::make_shared<race>();
+    std::future<void> legs[2];
+    size_t started = 0;
+    size_t first   = balancer::npos;
+    auto launch = [&](size_t exclude) {
+        auto con = _balancer.acquire(exclude, &first);
+        if (!con)
+            return false;
+        auto i = started++;
+        r->connections[i] = std::move(con);
+        r->starts[i]      = clock_type::now();
+
+        /* each leg gets its own copy, statement caches the query built for a connection */
+        legs[i] = std::async(std::launch::async, [r, i, s]{
+            result_stored* res = nullptr;
+            std::exception_ptr err;
+            try
+            {
+                res = r->connections[i]->execute_stored(s);
+            }
+            catch(...)
+            {
+                err = std::current_exception();
+            }
+            connection_ptr released;
+            {
+                std::lock_guard<std::mutex> lock(r->mutex);
+                r->results[i] = res;
+                r->errors[i]  = err;
+                ++r->done;
+                if (!err && r->winner == race::npos)
+                    r->winner = i;
+
+                /* only the winner is needed, all other connections go back to their pool right away */
+                if (r->winner != i)
+                {
+                    released      = std::move(r->connections[i]);
+                    r->results[i] = nullptr;
+                }
+                r->cond.notify_all();
+            }
+        });
+        return true;
+    };
+
+    if (!launch(balancer::npos))
+        throw exception("no replica available", error_code::Unknown);
+
+    auto d = delay();
+    std::unique_lock<std::mutex> lock(r->mutex);
+    if (    d != duration::max()
+        && !r->cond.wait_for(lock, d, [&r]{ return r->done > 0; }))
+    {
+        lock.unlock();
+        /* hedging on the replica that is already slow does not help */
+        if (acquire() && !launch(first))
+            refund();
+        lock.lock();
+    }
+    r->cond.wait(lock, [&r, &started]{
+        return r->winner != race::npos || r->done == started;
+    });
+
+    if (r->winner == race::npos)
+    {
+        lock.unlock();
+        for (size_t i = 0; i < started; ++i)
+            legs[i].wait();
+        std::rethrow_exception(r->errors[0] ? r->errors[0] : r->errors[1]);
+    }
+
+    auto w   = r->winner;
+    auto con = std::move(r->connections[w]);
+    auto res = r->results[w];
+    record(std::chrono::duration_cast<duration>(clock_type::now() - r->starts[w]));
+
+    /* the connection of the losing leg is set as long as its query is running, the lock
+     * keeps the leg from releasing it while the query is killed */
+    if (started > 1 && r->connections[1 - w])
+    {
+        try
+        {
+            r->connections[1 - w]->cancel();
+        }
+        catch(const exception&)
+            { }
+    }
+    lock.unlock();
+
+    if (started > 1)
+        drain(std::move(legs[1 - w]));
+    legs[w].wait();
+
+    multi_result ret;
+    ret.add(std::move(con), res);
+    return ret;
+}
+
+hedge::~hedge()
+{
+    for (auto& f : _draining)
+        f.wait();
+}
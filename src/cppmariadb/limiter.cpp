@@ -0,0 +1,105 @@
+#include <cmath>
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/pool.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/limiter.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/pool.inl>
+#include <cppmariadb/inline/limiter.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+void limiter::record(clock_type::duration d)
+{
+    static constexpr double short_decay = 0.2;
+    static constexpr double long_decay  = 0.01;
+
+    auto sample = std::chrono::duration<double, std::micro>(d).count();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto inflight = _inflight;
+
+        _short = (_short == 0.0) ? sample : _short + short_decay * (sample - _short);
+        _long  = (_long  == 0.0) ? sample : _long  + long_decay  * (sample - _long);
+
+        /* let the long term latency follow a permanent improvement faster */
+        if (_long > 2.0 * _short)
+            _long *= 0.95;
+
+        /* the limit is only adjusted if it is actually used */
+        if (static_cast<double>(inflight) >= _limit / 2.0 && _short > 0.0)
+        {
+            auto gradient = std::max(0.5, std::min(1.0, _tolerance * _long / _short));
+            auto next     = _limit * gradient + std::sqrt(_limit);
+            _limit = _limit * (1.0 - _smoothing) + next * _smoothing;
+            _limit = std::max(_min_limit, std::min(_max_limit, _limit));
+        }
+    }
+    _cond.notify_all();
+}
+
+void limiter::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_inflight;
+    }
+    _cond.notify_all();
+}
+
+connection_ptr limiter::acquire(time_point deadline)
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto ready = [this]{
+            return static_cast<double>(_inflight) < std::floor(_limit);
+        };
+        if (!ready() && _queued >= _max_queue)
+            throw overload_exception("concurrency limit exceeded", error_code::Unknown);
+
+        ++_queued;
+        bool success = true;
+        if (deadline == time_point::max())
+            _cond.wait(lock, ready);
+        else
+            success = _cond.wait_until(lock, deadline, ready);
+        --_queued;
+        if (!success)
+            throw timeout_exception("deadline exceeded while waiting for the concurrency limit", error_code::StatementTimeout);
+        ++_inflight;
+    }
+
+    connection_ptr con;
+    try
+    {
+        con = _pool.acquire(deadline);
+    }
+    catch(...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_inflight;
+        }
+        _cond.notify_one();
+        throw;
+    }
+
+    /* the limit is adjusted by the query round trip times, not by the time the caller
+     * holds the connection */
+    auto ptr  = con.get();
+    auto prev = ptr->observer();
+    ptr->observer([this, prev](clock_type::duration d) {
+        record(d);
+        if (prev)
+            prev(d);
+    });
+    return connection_ptr(ptr, [this, prev = std::move(prev), con = std::move(con)](connection* c) mutable {
+        c->observer(std::move(prev));
+        con.reset();
+        release();
+    });
+}
@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/field.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/decimal.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+#include <cppmariadb/merge_result.h>
+
+#include <cppmariadb/inline/row.inl>
+#include <cppmariadb/inline/field.inl>
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/decimal.inl>
+#include <cppmariadb/inline/connection.inl>
+#include <cppmariadb/inline/merge_result.inl>
+
+using namespace ::cppmariadb;
+
+int merge_result::compare(const row& a, const row& b) const
+{
+    for (auto& o : _order)
+    {
+        auto fa = a.at(o.index);
+        auto fb = b.at(o.index);
+        int ret;
+        if (fa.is_null() || fb.is_null())
+        {
+            /* NULL is sorted before any other value, like the server does */
+            ret = static_cast<int>(!fa.is_null()) - static_cast<int>(!fb.is_null());
+        }
+        else if (o.numeric)
+        {
+            /* integers and decimals are compared exactly, only values that are no plain decimal
+             * numbers (exponent notation of FLOAT and DOUBLE) are compared as double; field
+             * data is always terminated by the client library */
+            decimal da, db;
+            if (    decimal::parse(fa.data(), fa.size(), decimal::auto_scale, da)
+                &&  decimal::parse(fb.data(), fb.size(), decimal::auto_scale, db))
+                ret = decimal::compare(da, db);
+            else
+            {
+                auto va = std::strtod(fa.data(), nullptr);
+                auto vb = std::strtod(fb.data(), nullptr);
+                ret = (va < vb) ? -1 : (va > vb ? 1 : 0);
+            }
+        }
+        else
+        {
+            ret = std::memcmp(fa.data(), fb.data(), std::min(fa.size(), fb.size()));
+            if (ret == 0)
+                ret = (fa.size() < fb.size()) ? -1 : (fa.size() > fb.size() ? 1 : 0);
+        }
+        if (ret != 0)
+            return (o.descending ? -ret : ret);
+    }
+    return 0;
+}
+
+bool merge_result::less(size_t a, size_t b) const
+{
+    auto c = compare(*_streams.at(a).current, *_streams.at(b).current);
+    return (c < 0 || (c == 0 && a < b));
+}
+
+void merge_result::push(size_t i)
+{
+    _heap.emplace_back(i);
+    std::push_heap(_heap.begin(), _heap.end(), [this](size_t a, size_t b){
+        return less(b, a);
+    });
+}
+
+void merge_result::add(connection_ptr con, result_used* res)
+{
+    auto i = _streams.size();
+    _streams.emplace_back(stream { std::move(con), res, nullptr });
+    auto& s = _streams.back();
+    s.current = (s.result ? s.result->next() : nullptr);
+    if (s.current)
+        push(i);
+}
+
+row* merge_result::next()
+{
+    if (_last != npos)
+    {
+        auto& s = _streams.at(_last);
+        s.current = s.result->next();
+        if (s.current)
+            push(_last);
+        _last = npos;
+    }
+
+    _row = nullptr;
+    if (_count >= _limit)
+    {
+        cancel();
+        return nullptr;
+    }
+    if (_heap.empty())
+        return nullptr;
+
+    std::pop_heap(_heap.begin(), _heap.end(), [this](size_t a, size_t b){
+        return less(b, a);
+    });
+    _last = _heap.back();
+    _heap.pop_back();
+    _row = _streams.at(_last).current;
+    ++_count;
+    return _row;
+}
+
+void merge_result::cancel()
+{
+    _heap.clear();
+    _last = npos;
+    for (auto& s : _streams)
+    {
+        if (!s.connection)
+            continue;
+        if (s.current)
+        {
+            /* the stream still has pending rows, abort the query on the server
+             * instead of transferring all of them just to throw them away */
+            try
+            {
+                s.connection->cancel();
+            }
+            catch(const exception&)
+                { }
+        }
+        s.current = nullptr;
+        s.result  = nullptr;
+        s.connection->free_result();
+        s.connection.reset();
+    }
+}
+
+merge_result::~merge_result()
+    { cancel(); }
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cppmariadb/pool.h>
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/pool.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+void pool::release(connection* c)
+{
+    connection_ptru_type ptr(c);
+
+    /* a pending result would break the next query of the next borrower */
+    ptr->free_result();
+    if (_reset && ptr->handle())
+    {
+        try
+        {
+            ptr->reset();
+        }
+        catch(const exception&)
+        {
+            ptr->close();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (ptr->handle())
+        {
+            ptr->deadline(time_point::max());
+            _idle.emplace_back(idle_entry { std::move(ptr), clock_type::now() });
+        }
+        else
+            --_count;
+    }
+    _cond.notify_one();
+}
+
+connection_ptr pool::take(time_point deadline, const credentials* c)
+{
+    auto matches = [c](const connection_ptru_type& p){
+        auto o = p->options();
+        return o
+            && o->user     == c->user
+            && o->database == c->database;
+    };
+
+    connection_ptru_type ptr;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto ready = [this]{
+            return !_idle.empty() || _count < _size;
+        };
+        if (deadline == time_point::max())
+            _cond.wait(lock, ready);
+        else if (!_cond.wait_until(lock, deadline, ready))
+            throw timeout_exception("deadline exceeded while waiting for a connection", error_code::StatementTimeout);
+        if (!_idle.empty())
+        {
+            /* most recently used connections first, they are the least likely to be timed out,
+             * connections of the requested user are preferred to avoid changing the user */
+            auto it = std::prev(_idle.end());
+            if (c)
+            {
+                auto r = std::find_if(_idle.rbegin(), _idle.rend(), [&matches](const idle_entry& e){
+                    return matches(e.con);
+                });
+                if (r != _idle.rend())
+                    it = std::prev(r.base());
+            }
+            ptr = std::move(it->con);
+            _idle.erase(it);
+        }
+        else
+            ++_count;
+    }
+
+    try
+    {
+        if (!ptr)
+            ptr.reset(new connection(_factory()));
+        if (c && !matches(ptr))
+            ptr->change_user(c->user, c->password, c->database);
+    }
+    catch(...)
+    {
+        ptr.reset();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_count;
+        }
+        _cond.notify_one();
+        throw;
+    }
+
+    ptr->deadline(deadline);
+    return connection_ptr(ptr.release(), [this](connection* c){
+        release(c);
+    });
+}
+
+connection_ptr pool::acquire()
+    { return take(time_point::max(), nullptr); }
+
+connection_ptr pool::acquire(time_point deadline)
+    { return take(deadline, nullptr); }
+
+connection_ptr pool::acquire(const credentials& c, time_point deadline)
+    { return take(deadline, &c); }
+
+void pool::maintain()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto ping_interval = _ping_interval;
+    auto max_idle      = _max_idle;
+    auto start         = clock_type::now();
+
+    /* one connection is checked per lock cycle, so borrowers never wait for the pings,
+     * dropped connections are replaced on demand by take() */
+    while (true)
+    {
+        auto it = std::find_if(_idle.begin(), _idle.end(), [&](const idle_entry& e){
+            return start - e.since >= ping_interval;
+        });
+        if (it == _idle.end())
+            break;
+        auto e = std::move(*it);
+        _idle.erase(it);
+        lock.unlock();
+
+        auto keep = (max_idle == duration::zero() || clock_type::now() - e.since < max_idle)
+                 && e.con->ping();
+        if (!keep)
+            e.con.reset();
+
+        lock.lock();
+        if (keep)
+            _idle.emplace_front(idle_entry { std::move(e.con), clock_type::now() });
+        else
+            --_count;
+        _cond.notify_one();
+    }
+}
+
+void pool::run()
+{
+    database::thread_init();
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_running)
+    {
+        _keepalive_cond.wait_for(lock, _ping_interval / 2);
+        if (!_running)
+            break;
+        lock.unlock();
+        maintain();
+        lock.lock();
+    }
+}
+
+void pool::keepalive(duration ping_interval, duration max_idle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ping_interval = ping_interval;
+    _max_idle      = max_idle;
+    if (!_running)
+    {
+        _running   = true;
+        _keepalive = std::thread(&pool::run, this);
+    }
+    _keepalive_cond.notify_all();
+}
+
+pool::~pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _keepalive_cond.notify_all();
+    if (_keepalive.joinable())
+        _keepalive.join();
+}
@@ -1,5 +1,6 @@
 #include <cppmariadb/result.h>
 #include <cppmariadb/column.h>
+#include <cppmariadb/exception.h>
 
 #include <cppmariadb/inline/row.inl>
 #include <cppmariadb/inline/result.inl>
@@ -8,20 +9,20 @@ using namespace ::cppmariadb;
 
 row* result::next()
 {
-    if (_is_initialized && !_row)
+    if (_is_initialized && !_row.handle())
         return nullptr;
 
     _is_initialized = true;
     auto r = mysql_fetch_row(handle());
-    if (r)
+    if (!r)
     {
-        _row.reset(new row(*this, r));
-        ++_rowindex;
+        _row.bind(nullptr, nullptr);
+        return nullptr;
     }
-    else
-        _row.reset();
 
-    return _row.get();
+    _row.bind(r, mysql_fetch_lengths(handle()));
+    ++_rowindex;
+    return &_row;
 }
 
 void result::update_columns() const
@@ -34,6 +35,26 @@ void result::update_columns() const
         _columns.emplace_back(f[i]);
 }
 
+void result::update_names() const
+{
+    auto& c = columns();
+    _names.clear();
+    _names.reserve(2 * c.size());
+    /* names take precedence over the original names of all columns */
+    for (size_t i = 0; i < c.size(); ++i)
+        _names.emplace(c[i].name, i);
+    for (size_t i = 0; i < c.size(); ++i)
+        _names.emplace(c[i].original_name, i);
+}
+
+column_handle result::column(std::string_view name) const
+{
+    auto i = find(name);
+    if (i == npos)
+        throw exception(std::string("unknown field name: ") + std::string(name), error_code::UnknownError);
+    return column_handle { i };
+}
+
 result::~result()
     { free(); }
 
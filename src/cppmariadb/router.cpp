@@ -0,0 +1,78 @@
+#include <cppmariadb/row.h>
+#include <cppmariadb/pool.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/router.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+#include <cppmariadb/transaction.h>
+
+#include <cppmariadb/inline/pool.inl>
+#include <cppmariadb/inline/router.inl>
+#include <cppmariadb/inline/connection.inl>
+#include <cppmariadb/inline/transaction.inl>
+
+using namespace ::cppmariadb;
+
+/* router::session ***************************************************************************/
+
+connection_ptr router::session::acquire(query_type type)
+{
+    if (_transaction)
+        return _primary;
+
+    auto now = clock_type::now();
+    if (    type == query_type::Read
+        &&  now - _last_write >= _router.window())
+        return _router.acquire_replica();
+
+    /* everything we can not prove to be a read is treated as a write */
+    if (type != query_type::Session)
+        _last_write = now;
+    return _router.acquire_primary();
+}
+
+void router::session::begin()
+{
+    if (_transaction)
+        throw exception("transaction is already active", error_code::Unknown);
+    auto con = _router.acquire_primary();
+    _transaction.reset(new transaction(*con));
+    _primary = std::move(con);
+}
+
+void router::session::commit()
+{
+    if (!_transaction)
+        throw exception("no active transaction", error_code::Unknown);
+    _last_write = clock_type::now();
+    _transaction->commit();
+    _transaction.reset();
+    _primary.reset();
+}
+
+void router::session::rollback()
+{
+    if (!_transaction)
+        throw exception("no active transaction", error_code::Unknown);
+    _transaction->rollback();
+    _transaction.reset();
+    _primary.reset();
+}
+
+router::session::~session()
+{
+    /* an open transaction is rolled back by its destructor before the connection is released */
+    _transaction.reset();
+}
+
+/* router ************************************************************************************/
+
+connection_ptr router::acquire_primary()
+    { return _primary.acquire(); }
+
+connection_ptr router::acquire_replica()
+{
+    /* fall back to the primary if no replica is available */
+    auto con = _balancer.acquire();
+    return (con ? con : _primary.acquire());
+}
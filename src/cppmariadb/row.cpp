@@ -8,39 +8,25 @@
 
 using namespace ::cppmariadb;
 
-size_t row::find(const std::string& name) const
+unsigned long* row::fetch_lengths() const
 {
-    auto& columns = _result.columns();
-    for (size_t i = 0; i < columns.size(); ++i)
-    {
-        if (columns.at(i).name == name)
-            return i;
-    }
-    for (size_t i = 0; i < columns.size(); ++i)
-    {
-        if (columns.at(i).original_name == name)
-            return i;
-    }
-    return npos;
+    _lengths = mysql_fetch_lengths(_result.handle());
+    if (!_lengths)
+        throw exception("unble to fetch lenghts for row", error_code::UnknownError);
+    return _lengths;
 }
 
 field row::at(size_t i) const
 {
     if (i >= size())
         throw exception("row index out of range", error_code::UnknownError);
-    if (!_lengths)
-    {
-        _lengths = mysql_fetch_lengths(_result.handle());
-        if (!_lengths)
-            throw exception("unble to fetch lenghts for row", error_code::UnknownError);
-    }
-    return field(*this, i, handle()[i], _lengths[i]);
+    return make_field(i);
 }
 
-field row::at(const std::string name) const
+field row::at(std::string_view name) const
 {
     auto i = find(name);
     if (i == npos)
-        throw exception(std::string("unknown field name: ") + name, error_code::UnknownError);
+        throw exception(std::string("unknown field name: ") + std::string(name), error_code::UnknownError);
     return at(i);
 }
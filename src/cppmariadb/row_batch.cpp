@@ -0,0 +1,295 @@
+#include <cstring>
+#include <charconv>
+#include <cppmariadb/row.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/row_batch.h>
+
+#include <cppmariadb/inline/row.inl>
+#include <cppmariadb/inline/field.inl>
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/row_batch.inl>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define CPPMARIADB_SIMD_X86
+#   include <immintrin.h>
+#endif
+
+using namespace ::cppmariadb;
+
+namespace
+{
+
+    /* view on the fields of one column of a batch */
+    struct column_view
+    {
+        const MYSQL_ROW*        rows;
+        const unsigned long*    lengths;
+        size_t                  stride;
+        size_t                  column;
+        size_t                  count;
+
+        inline const char* data(size_t i) const
+            { return rows[i][column]; }
+
+        inline size_t size(size_t i) const
+            { return lengths[i * stride + column]; }
+    };
+
+    /* integers: the digits (without sign) right aligned in a 16 byte slot */
+    struct op_int
+    {
+        using value_type = int64_t;
+
+        bool negative;
+
+        inline bool prepare(const char* c, size_t s, char* slot)
+        {
+            negative = (s > 0 && *c == '-');
+            auto d   = c + negative;
+            auto n   = s - negative;
+            if (n == 0 || n > 16)
+                return false;
+            memset(slot, '0', 16);
+            memcpy(slot + 16 - n, d, n);
+            return true;
+        }
+
+        inline value_type finish(uint64_t digits) const
+            { return negative ? -static_cast<int64_t>(digits) : static_cast<int64_t>(digits); }
+
+        static inline value_type fallback(const char* c, size_t s)
+            { return op_field_converter<int64_t>()(c, s); }
+    };
+
+    /* decimals: integer and fraction digits right aligned in a 16 byte slot, at most 15 digits
+     * so the mantissa is exact and one division by an exact power of ten is correctly rounded */
+    struct op_decimal
+    {
+        using value_type = double;
+
+        bool    negative;
+        size_t  scale;
+
+        inline bool prepare(const char* c, size_t s, char* slot)
+        {
+            negative  = (s > 0 && *c == '-');
+            auto d    = c + negative;
+            auto n    = s - negative;
+            auto dot  = static_cast<const char*>(memchr(d, '.', n));
+            auto head = dot ? static_cast<size_t>(dot - d) : n;
+            scale     = dot ? n - head - 1 : 0;
+            auto total = head + scale;
+            if (total == 0 || total > 15)
+                return false;
+            memset(slot, '0', 16);
+            memcpy(slot + 16 - total, d, head);
+            if (scale)
+                memcpy(slot + 16 - scale, dot + 1, scale);
+            return true;
+        }
+
+        inline value_type finish(uint64_t digits) const
+        {
+            static const double powers[] = {
+                1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+            auto ret = static_cast<double>(digits) / powers[scale];
+            return negative ? -ret : ret;
+        }
+
+        static inline value_type fallback(const char* c, size_t s)
+            { return op_field_converter<double>()(c, s); }
+    };
+
+    /* parses the fields of a column with a kernel that converts K::width slots of 16 digits
+     * at once, fields that do not fit into a slot (or contain other characters than digits)
+     * are converted by the scalar fallback */
+    template<class K, class Op>
+    void parse_column(const column_view& v, typename Op::value_type* values, null_bitmap& nulls)
+    {
+        alignas(32) char slots[16 * K::width];
+        uint64_t    digits[K::width];
+        size_t      index [K::width];
+        Op          ops   [K::width];
+        size_t      used = 0;
+
+        auto flush = [&]() {
+            for (size_t j = used; j < K::width; ++j)
+                memset(slots + 16 * j, '0', 16);
+            auto valid = K::parse(slots, digits);
+            for (size_t j = 0; j < used; ++j)
+            {
+                auto i = index[j];
+                values[i] = (valid & (1u << j))
+                    ? ops[j].finish(digits[j])
+                    : Op::fallback(v.data(i), v.size(i));
+            }
+            used = 0;
+        };
+
+        for (size_t i = 0; i < v.count; ++i)
+        {
+            auto c = v.data(i);
+            if (!c)
+            {
+                nulls.set(i);
+                values[i] = 0;
+                continue;
+            }
+            auto s = v.size(i);
+            if (!ops[used].prepare(c, s, slots + 16 * used))
+            {
+                values[i] = Op::fallback(c, s);
+                continue;
+            }
+            index[used] = i;
+            if (++used == K::width)
+                flush();
+        }
+        if (used)
+            flush();
+    }
+
+    template<class Op>
+    void parse_column_scalar(const column_view& v, typename Op::value_type* values, null_bitmap& nulls)
+    {
+        for (size_t i = 0; i < v.count; ++i)
+        {
+            auto c = v.data(i);
+            if (!c)
+            {
+                nulls.set(i);
+                values[i] = 0;
+            }
+            else
+                values[i] = Op::fallback(c, v.size(i));
+        }
+    }
+
+#ifdef CPPMARIADB_SIMD_X86
+
+    /* '0'..'9' -> 0..9, two digits -> 16 bit, four digits -> 32 bit, eight digits -> 32 bit */
+    struct kernel_sse41
+    {
+        static constexpr size_t width = 1;
+
+        __attribute__((target("sse4.1")))
+        static unsigned parse(const char* slots, uint64_t* digits)
+        {
+            const auto nine = _mm_set1_epi8(9);
+            auto d = _mm_sub_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots)),
+                _mm_set1_epi8('0'));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(d, nine), nine)) != 0xFFFF)
+                return 0;
+            d = _mm_maddubs_epi16(d, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+            d = _mm_madd_epi16   (d, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+            d = _mm_packus_epi32 (d, d);
+            d = _mm_madd_epi16   (d, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+            digits[0] = static_cast<uint64_t>(static_cast<uint32_t>(_mm_extract_epi32(d, 0))) * 100000000u
+                      + static_cast<uint32_t>(_mm_extract_epi32(d, 1));
+            return 1;
+        }
+    };
+
+    /* same as the SSE4.1 kernel, one field in each 128 bit lane */
+    struct kernel_avx2
+    {
+        static constexpr size_t width = 2;
+
+        __attribute__((target("avx2")))
+        static unsigned parse(const char* slots, uint64_t* digits)
+        {
+            const auto nine = _mm256_set1_epi8(9);
+            auto d = _mm256_sub_epi8(
+                _mm256_load_si256(reinterpret_cast<const __m256i*>(slots)),
+                _mm256_set1_epi8('0'));
+            auto mask  = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(d, nine), nine)));
+            auto valid = ((mask & 0xFFFFu) == 0xFFFFu ? 1u : 0u)
+                       | ((mask >> 16)     == 0xFFFFu ? 2u : 0u);
+            d = _mm256_maddubs_epi16(d, _mm256_set1_epi16(0x010A));
+            d = _mm256_madd_epi16   (d, _mm256_set1_epi32(0x00010064));
+            d = _mm256_packus_epi32 (d, d);
+            d = _mm256_madd_epi16   (d, _mm256_set1_epi32(0x00012710));
+            digits[0] = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_extract_epi32(d, 0))) * 100000000u
+                      + static_cast<uint32_t>(_mm256_extract_epi32(d, 1));
+            digits[1] = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_extract_epi32(d, 4))) * 100000000u
+                      + static_cast<uint32_t>(_mm256_extract_epi32(d, 5));
+            return valid;
+        }
+    };
+
+#endif
+
+    simd_level detect_simd_level()
+    {
+#ifdef CPPMARIADB_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return simd_level::Avx2;
+        if (__builtin_cpu_supports("sse4.1"))
+            return simd_level::Sse41;
+#endif
+        return simd_level::Scalar;
+    }
+
+    template<class Op>
+    void parse_column(const column_view& v, std::vector<typename Op::value_type>& values, null_bitmap& nulls, simd_level level)
+    {
+        values.resize(v.count);
+        nulls.reset(v.count);
+        switch (level)
+        {
+#ifdef CPPMARIADB_SIMD_X86
+            case simd_level::Avx2:
+                parse_column<kernel_avx2, Op>(v, values.data(), nulls);
+                break;
+            case simd_level::Sse41:
+                parse_column<kernel_sse41, Op>(v, values.data(), nulls);
+                break;
+#endif
+            default:
+                parse_column_scalar<Op>(v, values.data(), nulls);
+                break;
+        }
+    }
+
+}
+
+simd_level row_batch::detect_simd()
+{
+    static const auto level = detect_simd_level();
+    return level;
+}
+
+size_t row_batch::fetch(result_stored& res, size_t max_rows)
+{
+    _columns = res.columncount();
+    size_t ret = 0;
+    while (ret < max_rows)
+    {
+        auto r = res.next();
+        if (!r)
+            break;
+        auto l = r->lengths();
+        _rows.emplace_back(r->handle());
+        _lengths.insert(_lengths.end(), l, l + _columns);
+        ++ret;
+    }
+    return ret;
+}
+
+void row_batch::parse(size_t column, std::vector<int64_t>& values, null_bitmap& nulls) const
+{
+    if (column >= _columns)
+        throw exception("column index out of range", error_code::UnknownError);
+    parse_column<op_int>(column_view { _rows.data(), _lengths.data(), _columns, column, _rows.size() }, values, nulls, _simd);
+}
+
+void row_batch::parse(size_t column, std::vector<double>& values, null_bitmap& nulls) const
+{
+    if (column >= _columns)
+        throw exception("column index out of range", error_code::UnknownError);
+    parse_column<op_decimal>(column_view { _rows.data(), _lengths.data(), _columns, column, _rows.size() }, values, nulls, _simd);
+}
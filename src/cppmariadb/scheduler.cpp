@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/scheduler.h>
+#include <cppmariadb/connection.h>
+
+#include <cppmariadb/inline/scheduler.inl>
+#include <cppmariadb/inline/connection.inl>
+
+using namespace ::cppmariadb;
+
+void scheduler::grant(waiter& w, time_point now)
+{
+    auto& q    = _queues.at(w.cls);
+    auto  wait = std::chrono::duration_cast<duration>(now - w.enqueued);
+    ++_inflight;
+    ++q.stats.served;
+    ++q.stats.inflight;
+    q.stats.total_wait += wait;
+    q.stats.max_wait    = std::max(q.stats.max_wait, wait);
+    _vtime    = std::max(_vtime, w.finish);
+    w.granted = true;
+}
+
+void scheduler::dispatch()
+{
+    auto now = clock_type::now();
+    while (true)
+    {
+        queue* next = nullptr;
+        for (auto& q : _queues)
+        {
+            if (q.waiters.empty() || !allowed(q.waiters.front()->cls))
+                continue;
+            if (!next)
+            {
+                next = &q;
+                continue;
+            }
+
+            /* waiters that exceeded the aging interval are served by their arrival,
+             * all others by their virtual finish time */
+            auto a = q.waiters.front();
+            auto b = next->waiters.front();
+            auto a_aged = (now - a->enqueued >= _aging);
+            auto b_aged = (now - b->enqueued >= _aging);
+            if (a_aged != b_aged
+                    ? a_aged
+                    : (a_aged
+                        ? a->enqueued < b->enqueued
+                        : a->finish < b->finish))
+                next = &q;
+        }
+        if (!next)
+            return;
+
+        auto w = next->waiters.front();
+        next->waiters.pop_front();
+        grant(*w, now);
+        w->cond.notify_one();
+    }
+}
+
+void scheduler::release(size_t cls)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_inflight;
+    --_queues.at(cls).stats.inflight;
+    dispatch();
+}
+
+connection_ptr scheduler::acquire(size_t cls, time_point deadline)
+{
+    if (cls >= _queues.size())
+        throw exception("invalid priority class", error_code::Unknown);
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto& q   = _queues.at(cls);
+        auto  now = clock_type::now();
+
+        waiter w;
+        w.cls      = cls;
+        w.enqueued = now;
+        w.finish   = std::max(_vtime, q.finish) + 1.0 / q.weight;
+        w.granted  = false;
+        q.finish   = w.finish;
+        q.waiters.emplace_back(&w);
+        dispatch();
+
+        auto ready = [&w]{ return w.granted; };
+        if (deadline == time_point::max())
+            w.cond.wait(lock, ready);
+        else if (!w.cond.wait_until(lock, deadline, ready))
+        {
+            q.waiters.erase(std::find(q.waiters.begin(), q.waiters.end(), &w));
+            throw timeout_exception("deadline exceeded while waiting for a connection", error_code::StatementTimeout);
+        }
+    }
+
+    connection_ptr con;
+    try
+    {
+        con = _pool.acquire(deadline);
+    }
+    catch(...)
+    {
+        release(cls);
+        throw;
+    }
+
+    auto ptr = con.get();
+    return connection_ptr(ptr, [this, cls, con = std::move(con)](connection*) mutable {
+        con.reset();
+        release(cls);
+    });
+}
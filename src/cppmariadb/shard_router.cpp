@@ -0,0 +1,195 @@
+#include <mutex>
+#include <future>
+#include <algorithm>
+#include <cppmariadb/row.h>
+#include <cppmariadb/column.h>
+#include <cppmariadb/result.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/connection.h>
+#include <cppmariadb/shard_router.h>
+
+#include <cppmariadb/inline/result.inl>
+#include <cppmariadb/inline/connection.inl>
+#include <cppmariadb/inline/merge_result.inl>
+#include <cppmariadb/inline/aggregate_result.inl>
+#include <cppmariadb/inline/shard_router.inl>
+
+using namespace ::cppmariadb;
+
+/* multi_result ******************************************************************************/
+
+const column_vector& multi_result::columns() const
+{
+    static const column_vector empty;
+    for (auto& e : _results)
+    {
+        if (e.second)
+            return e.second->columns();
+    }
+    return empty;
+}
+
+unsigned long long multi_result::rowcount() const
+{
+    unsigned long long ret = 0;
+    for (auto& e : _results)
+    {
+        if (e.second)
+            ret += e.second->rowcount();
+    }
+    return ret;
+}
+
+row* multi_result::next()
+{
+    _row = nullptr;
+    while (!_row && _index < _results.size())
+    {
+        auto res = _results.at(_index).second;
+        _row = (res ? res->next() : nullptr);
+        if (!_row)
+            ++_index;
+    }
+    return _row;
+}
+
+/* shard_router ******************************************************************************/
+
+uint64_t shard_router::hash(const char* data, size_t size)
+{
+    /* FNV-1a followed by the splitmix64 finalizer to spread similar keys over the ring */
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27; h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+void shard_router::add(const std::string& name, ::cppmariadb::pool& p)
+{
+    auto index = _shards.size();
+    _shards.emplace_back(shard { name, &p });
+    _ring.reserve(_ring.size() + _vnodes);
+    for (size_t i = 0; i < _vnodes; ++i)
+    {
+        auto vnode = name + "#" + std::to_string(i);
+        _ring.emplace_back(hash(vnode.data(), vnode.size()), index);
+    }
+    std::sort(_ring.begin(), _ring.end());
+}
+
+size_t shard_router::shard_for(const std::string& key) const
+{
+    if (_ring.empty())
+        throw exception("shard router has no shards", error_code::Unknown);
+    auto h  = hash(key.data(), key.size());
+    auto it = std::lower_bound(_ring.begin(), _ring.end(), ring_entry(h, 0));
+    if (it == _ring.end())
+        it = _ring.begin();
+    return it->second;
+}
+
+multi_result shard_router::multi_get(
+    const statement&                s,
+    const std::string&              param,
+    const std::vector<std::string>& keys) const
+{
+    std::vector<std::vector<const std::string*>> groups(_shards.size());
+    for (auto& key : keys)
+        groups.at(shard_for(key)).emplace_back(&key);
+
+    using future_type = std::future<std::pair<connection_ptr, result_stored*>>;
+    std::vector<future_type> futures;
+    futures.reserve(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        auto& group = groups.at(i);
+        if (group.empty())
+            continue;
+        futures.emplace_back(std::async(std::launch::async, [this, i, &group, &s, &param]{
+            auto con = at(i).acquire();
+            std::string list;
+            for (auto key : group)
+            {
+                if (!list.empty())
+                    list += ',';
+                list += '\'';
+                list += con->escape(*key);
+                list += '\'';
+            }
+            statement tmp(s);
+            tmp.set(param, list);
+            auto res = con->execute_stored(tmp);
+            return std::make_pair(std::move(con), res);
+        }));
+    }
+
+    multi_result ret;
+    for (auto& f : futures)
+    {
+        auto r = f.get();
+        ret.add(std::move(r.first), r.second);
+    }
+    return ret;
+}
+
+merge_result shard_router::scatter(
+    const statement&            s,
+    std::vector<sort_column>    order,
+    size_t                      limit) const
+{
+    using future_type = std::future<std::pair<connection_ptr, result_used*>>;
+    std::vector<future_type> futures;
+    futures.reserve(_shards.size());
+    for (size_t i = 0; i < _shards.size(); ++i)
+    {
+        /* each task gets its own copy, statement caches the query built for a connection */
+        futures.emplace_back(std::async(std::launch::async, [this, i, s]{
+            auto con = at(i).acquire();
+            auto res = con->execute_used(s);
+            return std::make_pair(std::move(con), res);
+        }));
+    }
+
+    merge_result ret(std::move(order), limit);
+    for (auto& f : futures)
+    {
+        auto r = f.get();
+        ret.add(std::move(r.first), r.second);
+    }
+    return ret;
+}
+
+aggregate_result shard_router::aggregate(
+    const statement&                s,
+    std::vector<size_t>             group_columns,
+    std::vector<aggregate_column>   aggregates) const
+{
+    aggregate_result ret(std::move(group_columns), std::move(aggregates));
+    std::mutex mutex;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(_shards.size());
+    for (size_t i = 0; i < _shards.size(); ++i)
+    {
+        futures.emplace_back(std::async(std::launch::async, [this, i, s, &ret, &mutex]{
+            auto con = at(i).acquire();
+            auto res = con->execute_used(s);
+            if (!res)
+                return;
+            while (auto r = res->next())
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ret.merge(*r);
+            }
+        }));
+    }
+    for (auto& f : futures)
+        f.get();
+    return ret;
+}
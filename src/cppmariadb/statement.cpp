@@ -10,6 +10,7 @@ using namespace ::cppmariadb;
 
 void statement::parse(const std::string& query)
 {
+    _template = query;
     auto c = query.c_str();
     auto t = c;
     bool inParam = false;
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cppmariadb/database.h>
+#include <cppmariadb/exception.h>
+#include <cppmariadb/impl/watchdog.h>
+
+using namespace ::cppmariadb;
+using namespace ::cppmariadb::__impl;
+
+void watchdog::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_running)
+    {
+        if (_entries.empty())
+        {
+            _cond.wait(lock);
+            continue;
+        }
+
+        auto it = _entries.begin();
+        if (clock_type::now() < it->first)
+        {
+            _cond.wait_until(lock, it->first);
+            continue;
+        }
+
+        auto e = it->second;
+        _entries.erase(it);
+        e->status = state::firing;
+        kill(std::move(e));
+    }
+}
+
+void watchdog::kill(entry_ptrs_type e)
+{
+    _kills.erase(
+        std::remove_if(_kills.begin(), _kills.end(), [](const std::future<void>& f){
+            return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }),
+        _kills.end());
+
+    _kills.emplace_back(std::async(std::launch::async, [this, e]{
+        /* the query may have finished in the meantime, KILL QUERY is harmless then */
+        try
+        {
+            database::kill_query(e->options, e->thread_id);
+        }
+        catch(const exception&)
+            { }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        e->status = state::fired;
+        _cond.notify_all();
+    }));
+}
+
+void watchdog::unwatch(const entry_map::iterator& it, const entry_ptrs_type& e)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (e->status == state::waiting)
+    {
+        _entries.erase(it);
+        return;
+    }
+
+    /* the connection must not go away while the watchdog is still killing its query */
+    _cond.wait(lock, [&e]{
+        return e->status == state::fired;
+    });
+}
+
+watchdog& watchdog::instance()
+{
+    static watchdog value;
+    return value;
+}
+
+watchdog::guard_ptru_type watchdog::watch(clock_type::time_point deadline, const connect_options& options, unsigned long thread_id)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_thread.joinable())
+    {
+        _running = true;
+        _thread  = std::thread(&watchdog::run, this);
+    }
+    auto e  = std::make_shared<entry>(entry { options, thread_id, state::waiting });
+    auto it = _entries.emplace(deadline, e);
+    if (it == _entries.begin())
+        _cond.notify_all();
+    return guard_ptru_type(new guard(*this, it, std::move(e)));
+}
+
+watchdog::watchdog()
+    : _running(false)
+    { }
+
+watchdog::~watchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _cond.notify_all();
+    if (_thread.joinable())
+        _thread.join();
+    for (auto& f : _kills)
+        f.wait();
+}
@@ -1,3 +1,6 @@
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include <memory>
 #include <type_traits>
 #include <gtest/gtest.h>
@@ -27,6 +30,30 @@ TEST(MariaDbTests, MariaDB_connect)
     EXPECT_EQ(reinterpret_cast<MYSQL*>(0x123), con.handle());
 }
 
+TEST(MariaDbTests, MariaDB_threadInit)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillRepeatedly(Return(reinterpret_cast<MYSQL*>(0x123)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x123), _, _, _, _, _, _, _))
+        .WillRepeatedly(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(2);
+
+    {
+        InSequence seq;
+        EXPECT_CALL(mock, mysql_thread_init())
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, mysql_thread_end())
+            .Times(1);
+    }
+
+    std::thread([]{
+        auto c0 = database::connect("testhost", 3306, "testuser", "password", "database", client_flags::empty());
+        auto c1 = database::connect("testhost", 3306, "testuser", "password", "database", client_flags::empty());
+    }).join();
+}
+
 TEST(MariaDbTests, MariaDB_errorCode)
 {
     StrictMock<MariaDbMock> mock;
@@ -56,6 +83,18 @@ TEST(MariaDbTests, MariaDB_errorMessage)
     }
 }
 
+TEST(MariaDbTests, MariaDB_queryType)
+{
+    EXPECT_EQ(query_type::Unknown,      database::query_type(""));
+    EXPECT_EQ(query_type::Read,         database::query_type("SELECT * FROM blubb"));
+    EXPECT_EQ(query_type::Read,         database::query_type("  /* comment */ (select 1)"));
+    EXPECT_EQ(query_type::Read,         database::query_type("-- comment\nSHOW TABLES"));
+    EXPECT_EQ(query_type::Write,        database::query_type("INSERT INTO blubb VALUES (1)"));
+    EXPECT_EQ(query_type::Write,        database::query_type("update blubb SET a=1"));
+    EXPECT_EQ(query_type::Session,      database::query_type("SET NAMES utf8mb4"));
+    EXPECT_EQ(query_type::Transaction,  database::query_type("START TRANSACTION"));
+}
+
 /**********************************************************************************************************/
 TEST(MariaDbTests, Connection_fieldcount)
 {
@@ -250,6 +289,133 @@ TEST(MariaDbTests, Connection_executeStored_success)
     EXPECT_EQ  (reinterpret_cast<MYSQL_RES*>(0x8888), ret->handle());
 }
 
+TEST(MariaDbTests, Connection_metadataCache)
+{
+    std::string name ("index");
+    std::string table("user");
+    MYSQL_FIELD fields[2];
+    memset(&fields[0], 0, sizeof(fields));
+    for (auto& f : fields)
+    {
+        f.name             = const_cast<char*>(name.c_str());
+        f.org_name         = const_cast<char*>(name.c_str());
+        f.table            = const_cast<char*>(table.c_str());
+        f.org_table        = const_cast<char*>(table.c_str());
+        f.name_length      = static_cast<unsigned int>(name.size());
+        f.org_name_length  = static_cast<unsigned int>(name.size());
+        f.table_length     = static_cast<unsigned int>(table.size());
+        f.org_table_length = static_cast<unsigned int>(table.size());
+        f.type             = MYSQL_TYPE_LONG;
+    }
+    fields[1].type = MYSQL_TYPE_STRING;
+
+    StrictMock<MariaDbMock> mock;
+    InSequence seq;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x6818), StrEq("SELECT * FROM blubb"), 19))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x6818)))
+            .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8880 + i)));
+        EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .WillOnce(Return(&fields[i / 2]));
+        EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .Times(1);
+    }
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x6818)))
+        .Times(1);
+
+    column_cache cache;
+    connection con(reinterpret_cast<MYSQL*>(0x6818));
+    con.metadata_cache(&cache);
+
+    auto first = &con.execute_stored("SELECT * FROM blubb")->columns();
+    ASSERT_EQ(1, first->size());
+    EXPECT_EQ(name, first->at(0).name);
+    EXPECT_NE(name.data(), first->at(0).name.data());
+
+    auto second = &con.execute_stored("SELECT * FROM blubb")->columns();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, cache.size());
+
+    auto third = &con.execute_stored("SELECT * FROM blubb")->columns();
+    ASSERT_EQ(1, third->size());
+    EXPECT_EQ(column_type::String, third->at(0).type);
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST(MariaDbTests, Connection_metadataCache_statement)
+{
+    std::string name("index");
+    MYSQL_FIELD fields[1];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].name        = const_cast<char*>(name.c_str());
+    fields[0].name_length = static_cast<unsigned int>(name.size());
+
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_escape_string(reinterpret_cast<MYSQL*>(0x6818), _, _, _))
+        .WillRepeatedly(Invoke([](MYSQL*, char* to, const char* from, unsigned long length){
+            memcpy(to, from, length);
+            return length;
+        }));
+    InSequence seq;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto query = "SELECT * FROM blubb WHERE id='" + std::to_string(i) + "'";
+        EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x6818), StrEq(query), query.size()))
+            .WillOnce(Return(0));
+        EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x6818)))
+            .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8880 + i)));
+        EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .WillOnce(Return(&fields[0]));
+        EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8880 + i)))
+            .Times(1);
+    }
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x6818)))
+        .Times(1);
+
+    column_cache cache;
+    connection con(reinterpret_cast<MYSQL*>(0x6818));
+    con.metadata_cache(&cache);
+
+    statement s("SELECT * FROM blubb WHERE id=?id?");
+    s.set("id", 0);
+    auto first = &con.execute_stored(s)->columns();
+    s.set("id", 1);
+    auto second = &con.execute_stored(s)->columns();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST(MariaDbTests, ColumnCache_lookup_evictLeastRecentlyUsed)
+{
+    std::string name("index");
+    MYSQL_FIELD fields[1];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].name        = const_cast<char*>(name.c_str());
+    fields[0].name_length = static_cast<unsigned int>(name.size());
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_fetch_fields(_))
+        .WillRepeatedly(Return(&fields[0]));
+    EXPECT_CALL(mock, mysql_num_fields(_))
+        .WillRepeatedly(Return(1));
+
+    auto res = reinterpret_cast<MYSQL_RES*>(0x8880);
+    column_cache cache(2);
+    auto a = cache.lookup("a", res);
+    auto b = cache.lookup("b", res);
+    EXPECT_EQ(a, cache.lookup("a", res));
+    cache.lookup("c", res);
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(a, cache.lookup("a", res));
+    EXPECT_NE(b, cache.lookup("b", res));
+}
+
 /**********************************************************************************************************/
 TEST(MariaDbTests, Connection_executeUsed_queryFailed)
 {
@@ -333,6 +499,266 @@ TEST(MariaDbTests, Connection_executeUsed_success)
     EXPECT_EQ  (reinterpret_cast<MYSQL_RES*>(0x8888), ret->handle());
 }
 
+/**********************************************************************************************************/
+TEST(MariaDbTests, Connection_autoReconnect_retryRead)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).WillRepeatedly(Return(CR_SERVER_GONE_ERROR));
+    EXPECT_CALL(mock, mysql_error(_)).Times(AnyNumber());
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillOnce(Return(reinterpret_cast<MYSQL*>(0x123)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x123), _, _, _, _, _, _, _))
+        .WillOnce(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SET time_zone = '+00:00'"), 24))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x123)))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SELECT * FROM blubb"), 19))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillOnce(Return(reinterpret_cast<MYSQL*>(0x124)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x124), _, _, _, _, _, _, _))
+        .WillOnce(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x124), StrEq("SET time_zone = '+00:00'"), 24))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x124)))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x124), StrEq("SELECT * FROM blubb"), 19))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x124)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8888)));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8888)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x124)))
+        .Times(1);
+
+    auto con = database::connect("testhost", 3306, "testuser", "password", "database", client_flags::empty());
+    con.auto_reconnect(true);
+    con.execute("SET time_zone = '+00:00'");
+    auto res = con.execute_stored("SELECT * FROM blubb");
+    ASSERT_TRUE(static_cast<bool>(res));
+    EXPECT_EQ  (reinterpret_cast<MYSQL*>(0x124), con.handle());
+    EXPECT_EQ  (1u, con.session().size());
+}
+
+TEST(MariaDbTests, Connection_autoReconnect_failFastWrite)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).WillRepeatedly(Return(CR_SERVER_LOST));
+    EXPECT_CALL(mock, mysql_error(_)).Times(AnyNumber());
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillOnce(Return(reinterpret_cast<MYSQL*>(0x123)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x123), _, _, _, _, _, _, _))
+        .WillOnce(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("DELETE FROM blubb"), 17))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillOnce(Return(reinterpret_cast<MYSQL*>(0x124)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x124), _, _, _, _, _, _, _))
+        .WillOnce(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x124)))
+        .Times(1);
+
+    auto con = database::connect("testhost", 3306, "testuser", "password", "database", client_flags::empty());
+    con.auto_reconnect(true);
+    EXPECT_THROW(con.execute("DELETE FROM blubb"), ::cppmariadb::exception);
+    EXPECT_EQ   (reinterpret_cast<MYSQL*>(0x124), con.handle());
+}
+
+TEST(MariaDbTests, Connection_autoReconnect_failFastTransaction)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).WillRepeatedly(Return(CR_SERVER_LOST));
+    EXPECT_CALL(mock, mysql_error(_)).Times(AnyNumber());
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(0));
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillOnce(Return(reinterpret_cast<MYSQL*>(0x123)));
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x123), _, _, _, _, _, _, _))
+        .WillOnce(ReturnArg<0>());
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("BEGIN"), 5))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SELECT * FROM blubb"), 19))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("COMMIT"), 6))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SET autocommit=0"), 16))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SELECT * FROM blubb"), 19))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+
+    auto con = database::connect("testhost", 3306, "testuser", "password", "database", client_flags::empty());
+    con.auto_reconnect(true);
+    con.execute("BEGIN");
+    EXPECT_TRUE (con.in_transaction());
+    EXPECT_THROW(con.execute("SELECT * FROM blubb"), ::cppmariadb::exception);
+    EXPECT_EQ   (reinterpret_cast<MYSQL*>(0x123), con.handle());
+    con.execute("COMMIT");
+    EXPECT_FALSE(con.in_transaction());
+
+    con.execute("SET autocommit=0");
+    EXPECT_TRUE (con.in_transaction());
+    EXPECT_THROW(con.execute("SELECT * FROM blubb"), ::cppmariadb::exception);
+    EXPECT_EQ   (reinterpret_cast<MYSQL*>(0x123), con.handle());
+}
+
+TEST(MariaDbTests, Connection_autoReconnect_notConnected)
+{
+    connection con(reinterpret_cast<MYSQL*>(0x123));
+    EXPECT_THROW(con.auto_reconnect(true), ::cppmariadb::exception);
+}
+
+TEST(MariaDbTests, Connection_ensureSession)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SET SESSION time_zone = '+00:00'"), 32))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("SET NAMES utf8mb4, transaction_isolation='READ-COMMITTED'"), 57))
+        .WillOnce(Return(0));
+
+    connection con(reinterpret_cast<MYSQL*>(0x123));
+    con.execute("SET SESSION time_zone = '+00:00'");
+    EXPECT_EQ(std::string("+00:00"), con.session_state().at("time_zone"));
+
+    connection::session_values_type values {
+        { "time_zone",              "'+00:00'" },
+        { "names",                  "utf8mb4" },
+        { "transaction_isolation",  "'READ-COMMITTED'" },
+    };
+    con.ensure_session(values);
+    con.ensure_session(values);
+    EXPECT_EQ(std::string("utf8mb4"),        con.session_state().at("names"));
+    EXPECT_EQ(std::string("READ-COMMITTED"), con.session_state().at("transaction_isolation"));
+}
+
+TEST(MariaDbTests, Connection_ensureSession_multiStatements)
+{
+    connect_options options { "testhost", 3306, "testuser", "password", "", client_flag::MultiStatements };
+
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x123)))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), StrEq("USE blubb; SET NAMES utf8mb4"), 28))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_next_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillOnce(Return(0))
+        .WillOnce(Return(-1));
+
+    connection con(reinterpret_cast<MYSQL*>(0x123), options);
+    connection::session_values_type values {
+        { "schema", "blubb" },
+        { "names",  "utf8mb4" },
+    };
+    con.ensure_session(values);
+    con.ensure_session(values);
+    EXPECT_EQ(std::string("blubb"),   con.session_state().at("schema"));
+    EXPECT_EQ(std::string("utf8mb4"), con.session_state().at("names"));
+}
+
+TEST(MariaDbTests, Connection_deadline)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x123), AllOf(StartsWith("SET STATEMENT max_statement_time="), EndsWith(" FOR DELETE FROM blubb")), _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x123)))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x123)))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x123)))
+        .Times(1);
+
+    connection con(reinterpret_cast<MYSQL*>(0x123));
+    con.server_timeout(server_timeout::MaxStatementTime);
+    con.deadline(connection::clock_type::now() + std::chrono::seconds(10));
+    con.execute("DELETE FROM blubb");
+
+    con.deadline(connection::clock_type::now() - std::chrono::seconds(1));
+    EXPECT_THROW(con.execute("DELETE FROM blubb"), timeout_exception);
+}
+
+TEST(MariaDbTests, Connection_deadline_independentKills)
+{
+    std::atomic<bool> killed[2] { { false }, { false } };
+    auto query = [&killed](MYSQL* h, const char*, unsigned long){
+        auto& k = killed[h == reinterpret_cast<MYSQL*>(0x100) ? 0 : 1];
+        for (size_t i = 0; i < 2000 && !k.load(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 1;
+    };
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_thread_id(reinterpret_cast<MYSQL*>(0x100)))
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, mysql_thread_id(reinterpret_cast<MYSQL*>(0x200)))
+        .WillRepeatedly(Return(2));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x100), StrEq("SELECT SLEEP(10)"), 16))
+        .WillOnce(Invoke(query));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x200), StrEq("SELECT SLEEP(10)"), 16))
+        .WillOnce(Invoke(query));
+    EXPECT_CALL(mock, mysql_init(nullptr))
+        .WillRepeatedly(Return(reinterpret_cast<MYSQL*>(0x300)));
+    EXPECT_CALL(mock, mysql_options(reinterpret_cast<MYSQL*>(0x300), _, _))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_options(reinterpret_cast<MYSQL*>(0x300), MYSQL_OPT_CONNECT_TIMEOUT, _))
+        .Times(2);
+
+    /* the server of the first connection takes long to accept the kill connection */
+    EXPECT_CALL(mock, mysql_real_connect(reinterpret_cast<MYSQL*>(0x300), _, _, _, _, _, _, _))
+        .WillRepeatedly(Invoke([](MYSQL* h, const char* host, const char*, const char*, const char*, unsigned int, const char*, unsigned long){
+            if (std::string(host) == "slow")
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return h;
+        }));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x300), StartsWith("KILL QUERY "), _))
+        .WillRepeatedly(Invoke([&killed](MYSQL*, const char* q, unsigned long){
+            killed[std::string(q) == "KILL QUERY 1" ? 0 : 1] = true;
+            return 0;
+        }));
+
+    connection slow(reinterpret_cast<MYSQL*>(0x100), connect_options { "slow", 3306, "testuser", "password", "", client_flags::empty() });
+    connection fast(reinterpret_cast<MYSQL*>(0x200), connect_options { "fast", 3306, "testuser", "password", "", client_flags::empty() });
+    slow.deadline(connection::clock_type::now() + std::chrono::milliseconds(10));
+    fast.deadline(connection::clock_type::now() + std::chrono::milliseconds(20));
+
+    std::thread t([&slow]{
+        EXPECT_THROW(slow.execute("SELECT SLEEP(10)"), timeout_exception);
+    });
+    auto start = connection::clock_type::now();
+    EXPECT_THROW(fast.execute("SELECT SLEEP(10)"), timeout_exception);
+    EXPECT_LT(connection::clock_type::now() - start, std::chrono::milliseconds(250));
+    t.join();
+}
+
 /**********************************************************************************************************/
 TEST(MariaDbTests, Statement_set_validIndex)
 {
@@ -362,6 +788,18 @@ TEST(MariaDbTests, Statement_set_invalidName)
     EXPECT_THROW(s.set("foo", "test"), ::cppmariadb::exception);
 }
 
+TEST(MariaDbTests, Statement_set_decimal)
+{
+    StrictMock<MariaDbMock> mock;
+    statement s("UPDATE invoice SET total=?total! WHERE id=1");
+    s.set("total", decimal { -5, 2 });
+    EXPECT_EQ(std::string("-0.05"), s.value("total"));
+    s.set("total", decimal { 1234500, 3 });
+    EXPECT_EQ(std::string("1234.500"), s.value("total"));
+    s.set("total", decimal { 42, 0 });
+    EXPECT_EQ(std::string("42"), s.value("total"));
+}
+
 TEST(MariaDbTests, Statement_query)
 {
     StrictMock<MariaDbMock> mock;
@@ -382,14 +820,31 @@ TEST(MariaDbTests, Statement_query)
     EXPECT_EQ(std::string("SELECT * FROM 'test'"), ret);
 }
 
+TEST(MariaDbTests, Statement_type)
+{
+    statement s0("SELECT * FROM ?table!");
+    statement s1("INSERT INTO blubb VALUES (?id?)");
+    statement s2("SELECT GET_LOCK('blubb', 10)");
+    s2.type(query_type::Write);
+
+    EXPECT_EQ(query_type::Read,  s0.type());
+    EXPECT_EQ(query_type::Write, s1.type());
+    EXPECT_EQ(query_type::Write, s2.type());
+}
+
 /**********************************************************************************************************/
 TEST(MariaDbTests, Result_rowindex_next_current)
 {
     StrictMock<MariaDbMock> mock;
     InSequence seq;
     EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
-        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x15160)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x15160)));
+    EXPECT_CALL(mock, mysql_fetch_lengths(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(reinterpret_cast<unsigned long*>(0x15170)));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
         .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x15161)));
+    EXPECT_CALL(mock, mysql_fetch_lengths(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(reinterpret_cast<unsigned long*>(0x15171)));
     EXPECT_CALL(mock, mysql_data_seek(reinterpret_cast<MYSQL_RES*>(0x51651), 0))
         .Times(1);
     EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
@@ -397,13 +852,16 @@ TEST(MariaDbTests, Result_rowindex_next_current)
 
     result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
     EXPECT_EQ(-1, result.rowindex());
+    EXPECT_EQ(nullptr, result.current());
     auto row = result.next();
     ASSERT_TRUE(static_cast<bool>(row));
     EXPECT_EQ  (reinterpret_cast<MYSQL_ROW>(0x15160), row->handle());
     EXPECT_EQ  (0, result.rowindex());
 
+    auto first = row;
     row = result.next();
     ASSERT_TRUE(static_cast<bool>(row));
+    EXPECT_EQ  (first, row);
     EXPECT_EQ  (reinterpret_cast<MYSQL_ROW>(0x15161), row->handle());
     EXPECT_EQ  (1, result.rowindex());
 
@@ -592,11 +1050,14 @@ TEST(MariaDbTests, UsedResult_dtor)
 {
     StrictMock<MariaDbMock> mock;
     InSequence seq;
+    for (size_t i = 1; i <= 4; ++i)
+    {
+        EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
+            .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(i)));
+        EXPECT_CALL(mock, mysql_fetch_lengths(reinterpret_cast<MYSQL_RES*>(0x51651)))
+            .WillOnce(Return(reinterpret_cast<unsigned long*>(0x1000 + i)));
+    }
     EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
-        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x0001)))
-        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x0002)))
-        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x0003)))
-        .WillOnce(Return(reinterpret_cast<MYSQL_ROW>(0x0004)))
         .WillOnce(Return(nullptr));
     EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
         .Times(1);
@@ -736,6 +1197,46 @@ TEST(MariaDbTests, Row_at_validName)
     EXPECT_NO_THROW(row.at("username"));
 }
 
+TEST(MariaDbTests, Row_at_columnHandle)
+{
+    static const std::string original("pass");
+
+    MYSQL_FIELD fields[3];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].name            = const_cast<char*>(RowDataName0.c_str());
+    fields[0].name_length     = static_cast<unsigned int>(RowDataName0.size());
+    fields[1].name            = const_cast<char*>(RowDataName1.c_str());
+    fields[1].name_length     = static_cast<unsigned int>(RowDataName1.size());
+    fields[1].org_name        = const_cast<char*>(RowDataName0.c_str());
+    fields[1].org_name_length = static_cast<unsigned int>(RowDataName0.size());
+    fields[2].name            = const_cast<char*>(RowDataName2.c_str());
+    fields[2].name_length     = static_cast<unsigned int>(RowDataName2.size());
+    fields[2].org_name        = const_cast<char*>(original.c_str());
+    fields[2].org_name_length = static_cast<unsigned int>(original.size());
+
+    StrictMock<MariaDbMock> mock;
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(fields));
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillRepeatedly(Return(3));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .Times(1);
+
+    result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
+    EXPECT_EQ(0,                  result.find("index"));
+    EXPECT_EQ(2,                  result.find("pass"));
+    EXPECT_EQ(result_stored::npos, result.find("blubb"));
+    EXPECT_THROW(result.column("blubb"), ::cppmariadb::exception);
+
+    auto h = result.column("username");
+    EXPECT_EQ(1, h.index);
+
+    row row(result, const_cast<MYSQL_ROW>(&RowData[0]), &RowLengths[0]);
+    EXPECT_EQ(std::string("bergmann89"), row[h].get<std::string>());
+    EXPECT_EQ(std::string("secret"),     row.at(result.column("pass")).get<std::string>());
+}
+
 TEST(MariaDbTests, Row_iterator)
 {
     StrictMock<MariaDbMock> mock;
@@ -759,6 +1260,33 @@ TEST(MariaDbTests, Row_iterator)
     ASSERT_TRUE(it == row.end());
 }
 
+TEST(MariaDbTests, Row_iterator_rangeFor)
+{
+    static_assert(std::is_trivially_copyable<row::iterator_type>::value,       "row iterator is not trivially copyable");
+    static_assert(std::is_trivially_copyable<row::const_iterator_type>::value, "row iterator is not trivially copyable");
+
+    StrictMock<MariaDbMock> mock;
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillRepeatedly(Return(3));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .Times(1);
+
+    result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
+    row row(result, const_cast<MYSQL_ROW>(&RowData[0]), &RowLengths[0]);
+    std::vector<std::string> values;
+    for (auto& f : row)
+        values.emplace_back(f.get<std::string>());
+    EXPECT_EQ(std::vector<std::string>({ "2", "bergmann89", "secret" }), values);
+
+    auto it   = row.begin() + 1;
+    auto copy = it;
+    ++it;
+    EXPECT_EQ(1, copy->index());
+    EXPECT_EQ(std::string("bergmann89"), copy->get<std::string>());
+    EXPECT_EQ(2, it->index());
+}
+
 TEST(MariaDbTests, Row_const_iterator)
 {
     StrictMock<MariaDbMock> mock;
@@ -907,4 +1435,1016 @@ TEST(MariaDbTests, Field_get)
 
     EXPECT_EQ(123,                field0.get<int>());
     EXPECT_EQ(std::string("asd"), field1.get<std::string>());
-}
\ No newline at end of file
+}
+
+TEST(MariaDbTests, Field_get_views)
+{
+    static const char data[] = { 'a', '\0', 'b', '\xff' };
+
+    cppmariadb::result_stored  result  (reinterpret_cast<MYSQL_RES*>(0x51651));
+    cppmariadb::row            row     (result, const_cast<MYSQL_ROW>(&RowData[0]));
+    cppmariadb::field          field   (row, 1, data, sizeof(data));
+    cppmariadb::field          null    (row, 1, nullptr, 0);
+
+    auto view = field.get<std::string_view>();
+    EXPECT_EQ(static_cast<const char*>(data), view.data());
+    EXPECT_EQ(sizeof(data),                   view.size());
+
+    auto bytes = field.get<byte_span>();
+    EXPECT_EQ(reinterpret_cast<const std::byte*>(data), bytes.data);
+    ASSERT_EQ(sizeof(data), bytes.size);
+    EXPECT_EQ(std::byte(0x00), bytes[1]);
+    EXPECT_EQ(std::byte(0xff), bytes[3]);
+    EXPECT_EQ(4, bytes.end() - bytes.begin());
+
+    EXPECT_THROW(null.get<std::string_view>(), ::cppmariadb::exception);
+}
+
+TEST(MariaDbTests, Field_get_datetime)
+{
+    using namespace std::chrono;
+
+    MYSQL_FIELD fields[3];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].type = MYSQL_TYPE_DATE;
+    fields[1].type = MYSQL_TYPE_DATETIME;
+    fields[2].type = MYSQL_TYPE_TIME;
+
+    StrictMock<MariaDbMock> mock;
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(fields));
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(3));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .Times(1);
+
+    cppmariadb::result_stored  result  (reinterpret_cast<MYSQL_RES*>(0x51651));
+    cppmariadb::row            row     (result, const_cast<MYSQL_ROW>(&RowData[0]));
+    auto make = [&row](size_t index, const char* data) {
+        return cppmariadb::field(row, index, data, strlen(data));
+    };
+
+    auto date = make(0, "2024-02-29").get<datetime>();
+    EXPECT_EQ(2024, date.year);
+    EXPECT_EQ(2,    date.month);
+    EXPECT_EQ(29,   date.day);
+    EXPECT_EQ(0,    date.hour);
+
+    auto dt = make(1, "2009-02-13 23:31:30.12").get<datetime>();
+    EXPECT_EQ(23,     dt.hour);
+    EXPECT_EQ(31,     dt.minute);
+    EXPECT_EQ(30,     dt.second);
+    EXPECT_EQ(120000, dt.microsecond);
+
+    auto tp = make(1, "2009-02-13 23:31:30.000001").get<system_clock::time_point>();
+    EXPECT_EQ(1234567890000001ll, duration_cast<microseconds>(tp.time_since_epoch()).count());
+    EXPECT_EQ(-86400ll, duration_cast<seconds>(make(0, "1969-12-31").get<system_clock::time_point>().time_since_epoch()).count());
+
+    EXPECT_EQ(microseconds(-3020399999999ll), make(2, "-838:59:59.999999").get<microseconds>());
+    EXPECT_EQ(microseconds(3723000000ll),     make(2, "01:02:03").get<microseconds>());
+
+    EXPECT_THROW(make(0, "2024-02-29 10:00:00").get<datetime>(),           ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 10:00").get<datetime>(),              ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 10:00:00.1234567").get<datetime>(),   ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "0000-00-00 00:00:00").get<system_clock::time_point>(), ::cppmariadb::exception);
+    EXPECT_THROW(make(2, "01:02:03").get<datetime>(),                      ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 10:00:00").get<microseconds>(),       ::cppmariadb::exception);
+    EXPECT_THROW(make(2, "1:2:03").get<microseconds>(),                    ::cppmariadb::exception);
+
+    /* fields out of range */
+    EXPECT_EQ   (0, make(0, "0000-00-00").get<datetime>().month);
+    EXPECT_THROW(make(0, "2024-13-01").get<datetime>(),                    ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "2024-13-00").get<datetime>(),                    ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "2023-02-29").get<datetime>(),                    ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "2024-04-31").get<datetime>(),                    ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 24:00:00").get<datetime>(),           ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 10:60:00").get<datetime>(),           ::cppmariadb::exception);
+    EXPECT_THROW(make(1, "2024-02-29 10:00:60").get<system_clock::time_point>(), ::cppmariadb::exception);
+    EXPECT_THROW(make(2, "01:60:03").get<microseconds>(),                  ::cppmariadb::exception);
+
+    datetime invalid { 2024, 2, 30, 0, 0, 0, 0 };
+    EXPECT_THROW(invalid.to_time_point(), ::cppmariadb::exception);
+}
+
+TEST(MariaDbTests, Field_get_decimal)
+{
+    MYSQL_FIELD fields[2];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].type     = MYSQL_TYPE_NEWDECIMAL;
+    fields[0].decimals = 4;
+    fields[1].type     = MYSQL_TYPE_STRING;
+
+    StrictMock<MariaDbMock> mock;
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(fields));
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(2));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .Times(1);
+
+    cppmariadb::result_stored  result  (reinterpret_cast<MYSQL_RES*>(0x51651));
+    cppmariadb::row            row     (result, const_cast<MYSQL_ROW>(&RowData[0]));
+    auto make = [&row](size_t index, const char* data) {
+        return cppmariadb::field(row, index, data, strlen(data));
+    };
+
+    auto d = make(0, "-123.45").get<decimal>();
+    EXPECT_EQ(-1234500, static_cast<long long>(d.unscaled));
+    EXPECT_EQ(4,        d.scale);
+    EXPECT_EQ(std::string("-123.4500"), d.to_string());
+    EXPECT_TRUE(d == (decimal { -12345, 2 }));
+    EXPECT_TRUE(d != (decimal { -12345, 3 }));
+
+    auto e = make(1, "0.001").get<decimal>();
+    EXPECT_EQ(1, static_cast<long long>(e.unscaled));
+    EXPECT_EQ(3, e.scale);
+    EXPECT_DOUBLE_EQ(0.001, e.to_double());
+
+#ifdef __SIZEOF_INT128__
+    auto big = make(1, "12345678901234567890123456789.123456789").get<decimal>();
+    EXPECT_EQ(std::string("12345678901234567890123456789.123456789"), big.to_string());
+    EXPECT_THROW(make(1, "123456789012345678901234567890.123456789").get<decimal>(), ::cppmariadb::exception);
+#endif
+
+    EXPECT_THROW(make(0, "1.23456").get<decimal>(), ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "1.2.3").get<decimal>(),   ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "-").get<decimal>(),       ::cppmariadb::exception);
+    EXPECT_THROW(make(0, "1e5").get<decimal>(),     ::cppmariadb::exception);
+}
+
+TEST(MariaDbTests, Field_get_numeric)
+{
+    cppmariadb::result_stored  result  (reinterpret_cast<MYSQL_RES*>(0x51651));
+    cppmariadb::row            row     (result, const_cast<MYSQL_ROW>(&RowData[0]));
+    auto make = [&row](const char* data) {
+        return cppmariadb::field(row, 0, data, strlen(data));
+    };
+
+    EXPECT_EQ(-128,                     make("-128").get<int8_t>());
+    EXPECT_EQ(18446744073709551615ull,  make("18446744073709551615").get<uint64_t>());
+    EXPECT_EQ(-9223372036854775807ll-1, make("-9223372036854775808").get<long long>());
+    EXPECT_DOUBLE_EQ(-1.5e-3,           make("-1.5e-3").get<double>());
+    EXPECT_FLOAT_EQ (3.25f,             make("3.25").get<float>());
+    EXPECT_TRUE (make("1").get<bool>());
+    EXPECT_FALSE(make("0").get<bool>());
+    EXPECT_TRUE (make("42").get<bool>());
+    EXPECT_TRUE (make("TRUE").get<bool>());
+    EXPECT_FALSE(make("false").get<bool>());
+
+    EXPECT_THROW(make("128").get<int8_t>(),     ::cppmariadb::exception);
+    EXPECT_THROW(make("-1").get<unsigned>(),    ::cppmariadb::exception);
+    EXPECT_THROW(make("12a").get<int>(),        ::cppmariadb::exception);
+    EXPECT_THROW(make("").get<int>(),           ::cppmariadb::exception);
+    EXPECT_THROW(make("1.5x").get<double>(),    ::cppmariadb::exception);
+    EXPECT_THROW(make("yes").get<bool>(),       ::cppmariadb::exception);
+}
+
+TEST(MariaDbTests, RowBatch_parse)
+{
+    static const char* data[][2] =
+    {
+        { "0",                      "0.0"                   },
+        { "-42",                    "-12.5"                 },
+        { nullptr,                  nullptr                 },
+        { "1234567890123456",       "123456789.012345"      },
+        { "-9223372036854775808",   "1234567890.1234567"    },
+        { "17",                     "1e3"                   },
+        { "99999999",               ".25"                   },
+    };
+    static const size_t count = sizeof(data) / sizeof(data[0]);
+    unsigned long lengths[count][2];
+    for (size_t i = 0; i < count; ++i)
+        for (size_t j = 0; j < 2; ++j)
+            lengths[i][j] = data[i][j] ? strlen(data[i][j]) : 0;
+
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillRepeatedly(Return(2));
+    InSequence seq;
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
+            .WillOnce(Return(const_cast<MYSQL_ROW>(&data[i][0])));
+        EXPECT_CALL(mock, mysql_fetch_lengths(reinterpret_cast<MYSQL_RES*>(0x51651)))
+            .WillOnce(Return(&lengths[i][0]));
+    }
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x51651)))
+        .Times(1);
+
+    result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
+    row_batch batch;
+    EXPECT_EQ(count, batch.fetch(result, 100));
+    EXPECT_EQ(count, batch.size());
+
+    /* each kernel the cpu supports must give the same values as field::get */
+    for (auto level : { simd_level::Scalar, simd_level::Sse41, simd_level::Avx2 })
+    {
+        if (level > row_batch::detect_simd())
+            continue;
+        batch.simd(level);
+        ASSERT_EQ(level, batch.simd());
+
+        std::vector<int64_t> ints;
+        std::vector<double>  doubles;
+        null_bitmap          nulls;
+        batch.parse(0, ints, nulls);
+        ASSERT_EQ(count, ints.size());
+        EXPECT_EQ(1, nulls.count());
+        EXPECT_TRUE(nulls.test(2));
+        batch.parse(1, doubles, nulls);
+        ASSERT_EQ(count, doubles.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            row r(result, const_cast<MYSQL_ROW>(&data[i][0]), &lengths[i][0]);
+            if (r.at(0).is_null())
+            {
+                EXPECT_TRUE(nulls.test(i));
+                continue;
+            }
+            EXPECT_EQ(r.at(0).get<int64_t>(), ints[i])    << data[i][0] << " level " << static_cast<int>(level);
+            EXPECT_EQ(r.at(1).get<double>(),  doubles[i]) << data[i][1] << " level " << static_cast<int>(level);
+        }
+    }
+
+    std::vector<int64_t> ints;
+    null_bitmap nulls;
+    EXPECT_THROW(batch.parse(2, ints, nulls), ::cppmariadb::exception);
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, Pool_acquire_reuse)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+
+    size_t created = 0;
+    pool p([&created]{
+        ++created;
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 2);
+
+    auto c0 = p.acquire();
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), c0->handle());
+    EXPECT_EQ(1u, p.count());
+    EXPECT_EQ(0u, p.idle());
+
+    c0.reset();
+    EXPECT_EQ(1u, p.idle());
+
+    auto c1 = p.acquire();
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), c1->handle());
+    EXPECT_EQ(1u, created);
+}
+
+TEST(MariaDbTests, Pool_dropClosed)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(2);
+
+    size_t created = 0;
+    pool p([&created]{
+        ++created;
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 1);
+
+    auto c0 = p.acquire();
+    c0->close();
+    c0.reset();
+    EXPECT_EQ(0u, p.count());
+
+    auto c1 = p.acquire();
+    EXPECT_EQ(2u, created);
+}
+
+TEST(MariaDbTests, Pool_resetOnRelease)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).Times(AnyNumber());
+    EXPECT_CALL(mock, mysql_error(_)).Times(AnyNumber());
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_reset_connection(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_change_user(reinterpret_cast<MYSQL*>(0x1000), StrEq("tenant"), StrEq("secret"), StrEq("db")))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_reset_connection(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(1));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+
+    pool p([]{
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 1);
+    p.reset(true);
+
+    p.acquire().reset();
+    EXPECT_EQ(1u, p.idle());
+
+    auto c = p.acquire(credentials { "tenant", "secret", "db" });
+    EXPECT_EQ(std::string("db"), c->session_state().at("schema"));
+    c.reset();
+    EXPECT_EQ(0u, p.idle());
+    EXPECT_EQ(0u, p.count());
+}
+
+TEST(MariaDbTests, Pool_keepalive_replaceDead)
+{
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_ping(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, mysql_ping(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x2000)))
+        .Times(1);
+
+    std::atomic<size_t> created { 0 };
+    pool p([&created]{
+        return connection(reinterpret_cast<MYSQL*>(++created == 1 ? 0x1000 : 0x2000));
+    }, 1);
+    p.acquire().reset();
+    p.keepalive(std::chrono::milliseconds(2));
+
+    while (p.count() > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(0u, p.idle());
+    EXPECT_EQ(1u, created.load());
+
+    p.acquire().reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto c = p.acquire();
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x2000), c->handle());
+    EXPECT_EQ(1u, p.count());
+    EXPECT_EQ(2u, created.load());
+}
+
+TEST(MariaDbTests, Pool_acquire_deadline)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+
+    pool p([]{
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 1);
+
+    auto deadline = pool::clock_type::now() + std::chrono::milliseconds(10);
+    auto c0 = p.acquire(deadline);
+    EXPECT_EQ   (deadline, c0->deadline());
+    EXPECT_THROW(p.acquire(deadline), timeout_exception);
+
+    c0.reset();
+    auto c1 = p.acquire();
+    EXPECT_EQ(pool::time_point::max(), c1->deadline());
+}
+
+TEST(MariaDbTests, Limiter_acquire)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+
+    pool p([]{
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 4);
+    limiter l(p, 1);
+    l.max_queue(0);
+
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x1000), StrEq("DO 1"), 4))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillRepeatedly(Return(0));
+
+    /* holding a connection without sending queries does not influence the latency */
+    auto c0 = l.acquire();
+    EXPECT_EQ   (1u, l.inflight());
+    EXPECT_THROW(l.acquire(), overload_exception);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    c0.reset();
+    EXPECT_EQ   (0u, l.inflight());
+    EXPECT_EQ   (0.0, l.latency());
+
+    for (size_t i = 0; i < 10; ++i)
+        l.acquire()->execute("DO 1");
+    EXPECT_LT(0.0, l.latency());
+    EXPECT_LT(1u, l.limit());
+    EXPECT_EQ(0u, l.queued());
+}
+
+TEST(MariaDbTests, Scheduler_acquire_reservedAndPriority)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(2);
+
+    pool p([]{
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 2);
+    scheduler s(p, { 4.0, 1.0 }, 1);
+
+    auto batch = s.acquire(1);
+    EXPECT_THROW(s.acquire(1, scheduler::clock_type::now() + std::chrono::milliseconds(10)), timeout_exception);
+    auto interactive = s.acquire(0);
+    EXPECT_EQ(1u, s.stats(0).inflight);
+    EXPECT_EQ(1u, s.stats(1).inflight);
+
+    /* the interactive waiter is served before the batch waiter that arrived earlier */
+    std::vector<size_t> order;
+    std::mutex m;
+    auto t1 = std::thread([&]{ s.acquire(1); std::lock_guard<std::mutex> l(m); order.push_back(1); });
+    while (s.stats(1).waiting == 0)
+        std::this_thread::yield();
+    auto t0 = std::thread([&]{ s.acquire(0); std::lock_guard<std::mutex> l(m); order.push_back(0); });
+    while (s.stats(0).waiting == 0)
+        std::this_thread::yield();
+    interactive.reset();
+    t0.join();
+    batch.reset();
+    t1.join();
+
+    ASSERT_EQ(2u, order.size());
+    EXPECT_EQ(0u, order.at(0));
+    EXPECT_EQ(2u, s.stats(0).served);
+    EXPECT_EQ(2u, s.stats(1).served);
+}
+
+TEST(MariaDbTests, Executor_submit)
+{
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(2);
+
+    std::mutex m;
+    std::vector<std::thread::id> created;
+    {
+        executor e({ [&]{
+            std::lock_guard<std::mutex> lock(m);
+            created.emplace_back(std::this_thread::get_id());
+            return connection(reinterpret_cast<MYSQL*>(0x1000));
+        } }, 2);
+
+        std::vector<std::future<std::thread::id>> futures;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            futures.emplace_back(e.submit(i % 2, [](connection& c){
+                EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), c.handle());
+                return std::this_thread::get_id();
+            }));
+        }
+        std::vector<std::thread::id> ids;
+        for (auto& f : futures)
+            ids.emplace_back(f.get());
+        for (size_t i = 2; i < ids.size(); ++i)
+            EXPECT_EQ(ids.at(i % 2), ids.at(i));
+        EXPECT_NE(ids.at(0), ids.at(1));
+
+        auto f = e.submit([](connection&){ throw ::cppmariadb::exception("failed", error_code::Unknown); });
+        EXPECT_THROW(f.get(), ::cppmariadb::exception);
+    }
+    EXPECT_EQ(2u, created.size());
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, Router_session_acquire)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).Times(AnyNumber());
+    EXPECT_CALL(mock, mysql_error(_)).Times(AnyNumber());
+    EXPECT_CALL(mock, mysql_store_result(_)).WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x1000), StrEq("START TRANSACTION"), 17))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x1000), StrEq("COMMIT"), 6))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x2000)))
+        .Times(1);
+
+    pool primary([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool replica([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    router r(primary, { &replica }, std::chrono::seconds(60));
+
+    router::session s(r);
+    statement read ("SELECT * FROM blubb");
+    statement write("UPDATE blubb SET a=1");
+
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x2000), s.acquire(read)->handle());
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), s.acquire(write)->handle());
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), s.acquire(read)->handle());
+
+    router::session s2(r);
+    s2.begin();
+    EXPECT_TRUE(s2.in_transaction());
+    auto con = s2.acquire(read);
+    EXPECT_EQ(reinterpret_cast<MYSQL*>(0x1000), con->handle());
+    con.reset();
+    s2.commit();
+    EXPECT_FALSE(s2.in_transaction());
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, Balancer_acquire_queryLatency)
+{
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x1000), StrEq("DO 1"), 4))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+
+    pool replica([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    balancer b({ &replica });
+
+    /* holding a connection without sending queries does not influence the latency */
+    auto con = b.acquire();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    con.reset();
+    EXPECT_EQ(0.0, b.latency(0));
+
+    b.acquire()->execute("DO 1");
+    EXPECT_LT(0.0, b.latency(0));
+    EXPECT_EQ(0u,  b.inflight(0));
+    EXPECT_FALSE(static_cast<bool>(replica.acquire()->observer()));
+}
+
+TEST(MariaDbTests, Balancer_probe_ejectAndRestore)
+{
+    static const std::string name("Seconds_Behind_Master");
+    static const char* lag100[] = { "100" };
+    static const char* lag5[]   = { "5" };
+    static unsigned long lag100Lengths[] = { 3 };
+    static unsigned long lag5Lengths[]   = { 1 };
+
+    MYSQL_FIELD fields[1];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].name        = const_cast<char*>(name.c_str());
+    fields[0].name_length = static_cast<unsigned int>(name.size());
+
+    StrictMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SHOW SLAVE STATUS"), 17))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillRepeatedly(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_field_count(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(&lag100[0])))
+        .WillOnce(Return(nullptr))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(&lag5[0])))
+        .WillOnce(Return(nullptr));
+    EXPECT_CALL(mock, mysql_fetch_lengths(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillOnce(Return(&lag100Lengths[0]))
+        .WillOnce(Return(&lag5Lengths[0]));
+    EXPECT_CALL(mock, mysql_fetch_fields(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillRepeatedly(Return(&fields[0]));
+    EXPECT_CALL(mock, mysql_num_fields(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .Times(2);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x1000)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_close(reinterpret_cast<MYSQL*>(0x2000)))
+        .Times(1);
+
+    pool replica0([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool replica1([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    balancer b({ &replica0, &replica1 });
+
+    b.probe();
+    EXPECT_EQ  (100, b.lag(0));
+    EXPECT_EQ  (0,   b.lag(1));
+    EXPECT_TRUE(b.ejected(0));
+    EXPECT_FALSE(b.ejected(1));
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(reinterpret_cast<MYSQL*>(0x2000), b.acquire()->handle());
+    EXPECT_EQ(0u, b.inflight(1));
+
+    b.probe();
+    EXPECT_EQ   (5, b.lag(0));
+    EXPECT_FALSE(b.ejected(0));
+}
+
+TEST(MariaDbTests, Hedge_executeStored_slowReplica)
+{
+    std::atomic<MYSQL*> slow { nullptr };
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT * FROM blubb"), 19))
+        .Times(2)
+        .WillRepeatedly(Invoke([&slow](MYSQL* h, const char*, unsigned long){
+            MYSQL* expected = nullptr;
+            if (slow.compare_exchange_strong(expected, h))
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            return 0;
+        }));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8882)));
+
+    pool replica0([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool replica1([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    balancer b({ &replica0, &replica1 });
+    hedge h(b);
+    h.budget(1.0);
+    h.delay(std::chrono::milliseconds(10));
+
+    auto ret = h.execute_stored(statement("SELECT * FROM blubb"));
+    ASSERT_EQ(1u, ret.size());
+    EXPECT_EQ(slow.load() == reinterpret_cast<MYSQL*>(0x1000)
+        ? reinterpret_cast<MYSQL_RES*>(0x8882)
+        : reinterpret_cast<MYSQL_RES*>(0x8881), ret.at(0)->handle());
+    EXPECT_EQ(1u, h.reads());
+    EXPECT_EQ(1u, h.hedged());
+
+    /* the losing replica gets its connection back as soon as its query returned */
+    auto& loser = (slow.load() == reinterpret_cast<MYSQL*>(0x1000) ? replica0 : replica1);
+    auto  index = (slow.load() == reinterpret_cast<MYSQL*>(0x1000) ? 0u : 1u);
+    for (size_t i = 0; i < 200 && loser.idle() == 0; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(1u, loser.idle());
+    EXPECT_EQ(0u, b.inflight(index));
+    EXPECT_EQ(1u, b.inflight(1 - index));
+}
+
+TEST(MariaDbTests, Hedge_executeStored_singleReplica)
+{
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(reinterpret_cast<MYSQL*>(0x1000), StrEq("SELECT * FROM blubb"), 19))
+        .Times(1)
+        .WillOnce(Invoke([](MYSQL*, const char*, unsigned long){
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return 0;
+        }));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+
+    pool replica([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 2);
+    balancer b({ &replica });
+    hedge h(b);
+    h.budget(1.0);
+    h.delay(std::chrono::milliseconds(10));
+
+    auto ret = h.execute_stored(statement("SELECT * FROM blubb"));
+    ASSERT_EQ(1u, ret.size());
+    EXPECT_EQ(reinterpret_cast<MYSQL_RES*>(0x8881), ret.at(0)->handle());
+    EXPECT_EQ(0u, h.hedged());
+}
+
+TEST(MariaDbTests, Breaker_openAndClose)
+{
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_errno(_)).WillRepeatedly(Return(CR_SERVER_LOST));
+
+    InSequence seq;
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT * FROM blubb"), 19))
+        .Times(2)
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT 1"), 8))
+        .WillOnce(Return(0));
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT * FROM blubb"), 19))
+        .WillOnce(Return(0));
+
+    size_t created = 0;
+    pool p([&created]{
+        ++created;
+        return connection(reinterpret_cast<MYSQL*>(0x1000));
+    }, 1);
+    retry_budget budget;
+    breaker b(p, &budget);
+    b.min_requests(2);
+    b.cooldown(std::chrono::hours(1));
+
+    auto query = [](connection& con){ con.execute("SELECT * FROM blubb"); };
+    EXPECT_THROW(b.execute(query), ::cppmariadb::exception);
+    EXPECT_EQ   (breaker_state::Closed, b.state());
+    EXPECT_THROW(b.execute(query), ::cppmariadb::exception);
+    EXPECT_EQ   (breaker_state::Open, b.state());
+    EXPECT_THROW(b.execute(query), circuit_open_exception);
+    EXPECT_EQ   (2u, created);
+
+    b.cooldown(std::chrono::milliseconds(0));
+    EXPECT_NO_THROW(b.execute(query));
+    EXPECT_EQ      (breaker_state::Closed, b.state());
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, ShardRouter_shardFor)
+{
+    pool p0([]{ return connection(); }, 1);
+    pool p1([]{ return connection(); }, 1);
+    pool p2([]{ return connection(); }, 1);
+
+    shard_router r0(shard_router::parameter("id"));
+    r0.add("shard0", p0);
+    r0.add("shard1", p1);
+
+    std::vector<size_t> counts(2);
+    std::vector<size_t> before;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        auto s = r0.shard_for(std::to_string(i));
+        ++counts.at(s);
+        before.emplace_back(s);
+    }
+    EXPECT_GT(counts.at(0), 300u);
+    EXPECT_GT(counts.at(1), 300u);
+
+    /* adding a shard only moves keys to the new shard */
+    r0.add("shard2", p2);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        auto s = r0.shard_for(std::to_string(i));
+        EXPECT_TRUE(s == before.at(i) || s == 2);
+    }
+
+    statement s("SELECT * FROM customer WHERE id=?id?");
+    s.set("id", 17);
+    EXPECT_EQ(r0.shard_for("17"), r0.shard_for(s));
+}
+
+TEST(MariaDbTests, ShardRouter_multiGet)
+{
+    std::mutex mutex;
+    std::vector<std::string> queries;
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_escape_string(_, _, _, _))
+        .WillRepeatedly(Invoke([](MYSQL*, char* to, const char* from, unsigned long length){
+            memcpy(to, from, length);
+            return length;
+        }));
+    EXPECT_CALL(mock, mysql_real_query(_, _, _))
+        .WillRepeatedly(Invoke([&](MYSQL*, const char* q, unsigned long length){
+            std::lock_guard<std::mutex> lock(mutex);
+            queries.emplace_back(q, length);
+            return 0;
+        }));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+    EXPECT_CALL(mock, mysql_store_result(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8882)));
+    EXPECT_CALL(mock, mysql_num_rows(_))
+        .WillRepeatedly(Return(2));
+
+    pool p0([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool p1([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    shard_router r(shard_router::parameter("id"));
+    r.add("shard0", p0);
+    r.add("shard1", p1);
+
+    std::vector<std::string> keys;
+    std::vector<size_t> counts(2);
+    for (size_t i = 0; counts.at(0) < 2 || counts.at(1) < 2; ++i)
+    {
+        auto key = std::to_string(i);
+        auto s   = r.shard_for(key);
+        if (counts.at(s) >= 2)
+            continue;
+        ++counts.at(s);
+        keys.emplace_back(key);
+    }
+
+    statement s("SELECT * FROM customer WHERE id IN (?ids!)");
+    auto res = r.multi_get(s, "ids", keys);
+    EXPECT_EQ(2u, res.size());
+    EXPECT_EQ(4u, res.rowcount());
+    ASSERT_EQ(2u, queries.size());
+    for (auto& q : queries)
+        EXPECT_EQ(0u, q.find("SELECT * FROM customer WHERE id IN ('"));
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, ShardRouter_scatter_mergeWithLimit)
+{
+    static const char* rows0[][1] = { { "1" }, { "4" }, { "6" } };
+    static const char* rows1[][1] = { { "2" }, { "3" }, { "9" } };
+    static unsigned long lengths[] = { 1 };
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT id FROM log ORDER BY id LIMIT 4"), _))
+        .Times(2)
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_use_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+    EXPECT_CALL(mock, mysql_use_result(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8882)));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows0[0])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows0[1])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows0[2])))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x8882)))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows1[0])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows1[1])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows1[2])))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_fetch_lengths(_))
+        .WillRepeatedly(Return(&lengths[0]));
+    EXPECT_CALL(mock, mysql_num_fields(_))
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .Times(1);
+    EXPECT_CALL(mock, mysql_free_result(reinterpret_cast<MYSQL_RES*>(0x8882)))
+        .Times(1);
+
+    pool p0([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool p1([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    shard_router r(shard_router::parameter("id"));
+    r.add("shard0", p0);
+    r.add("shard1", p1);
+
+    statement s("SELECT id FROM log ORDER BY id LIMIT 4");
+    auto res = r.scatter(s, { sort_column { 0, false, true } }, 4);
+
+    std::vector<std::string> ids;
+    while (auto row = res.next())
+        ids.emplace_back(row->at(0).get<std::string>());
+    EXPECT_EQ(std::vector<std::string>({ "1", "2", "3", "4" }), ids);
+    EXPECT_EQ(4u, res.count());
+    EXPECT_EQ(2u, p0.idle() + p1.idle());
+}
+
+TEST(MariaDbTests, ShardRouter_scatter_mergeExact)
+{
+    static const char* rows0[][1] = { { "9007199254740993" }, { "9007199254740995" } };
+    static const char* rows1[][1] = { { "9007199254740992" }, { "9007199254740994" } };
+    static unsigned long lengths[] = { 16 };
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_real_query(_, StrEq("SELECT id FROM log ORDER BY id"), _))
+        .Times(2)
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mock, mysql_use_result(reinterpret_cast<MYSQL*>(0x1000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8881)));
+    EXPECT_CALL(mock, mysql_use_result(reinterpret_cast<MYSQL*>(0x2000)))
+        .WillOnce(Return(reinterpret_cast<MYSQL_RES*>(0x8882)));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x8881)))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows0[0])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows0[1])))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_fetch_row(reinterpret_cast<MYSQL_RES*>(0x8882)))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows1[0])))
+        .WillOnce(Return(const_cast<MYSQL_ROW>(rows1[1])))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mock, mysql_fetch_lengths(_))
+        .WillRepeatedly(Return(&lengths[0]));
+    EXPECT_CALL(mock, mysql_num_fields(_))
+        .WillRepeatedly(Return(1));
+
+    pool p0([]{ return connection(reinterpret_cast<MYSQL*>(0x1000)); }, 1);
+    pool p1([]{ return connection(reinterpret_cast<MYSQL*>(0x2000)); }, 1);
+    shard_router r(shard_router::parameter("id"));
+    r.add("shard0", p0);
+    r.add("shard1", p1);
+
+    /* the ids are above 2^53, they are not distinguishable as double */
+    statement s("SELECT id FROM log ORDER BY id");
+    auto res = r.scatter(s, { sort_column { 0, false, true } });
+
+    std::vector<std::string> ids;
+    while (auto row = res.next())
+        ids.emplace_back(row->at(0).get<std::string>());
+    EXPECT_EQ(std::vector<std::string>({
+        "9007199254740992", "9007199254740993", "9007199254740994", "9007199254740995" }), ids);
+}
+
+/**********************************************************************************************************/
+TEST(MariaDbTests, AggregateResult_merge)
+{
+    static const char* rows[][5] =
+    {
+        { "de",    "2", "10", "3", "7" },
+        { "us",    "1", "5",  "5", "5" },
+        { "de",    "3", "20", "1", "9" },
+        { nullptr, "1", "1",  "1", "1" },
+    };
+    static unsigned long lengths[][5] =
+    {
+        { 2, 1, 2, 1, 1 },
+        { 2, 1, 1, 1, 1 },
+        { 2, 1, 2, 1, 1 },
+        { 0, 1, 1, 1, 1 },
+    };
+    MYSQL_FIELD fields[5];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].type = MYSQL_TYPE_VAR_STRING;
+    fields[1].type = MYSQL_TYPE_LONGLONG;
+    fields[2].type = MYSQL_TYPE_NEWDECIMAL;
+    fields[3].type = MYSQL_TYPE_LONG;
+    fields[4].type = MYSQL_TYPE_LONG;
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_fetch_fields(_))
+        .WillRepeatedly(Return(fields));
+    EXPECT_CALL(mock, mysql_num_fields(_))
+        .WillRepeatedly(Return(5));
+    EXPECT_CALL(mock, mysql_fetch_lengths(_))
+        .WillOnce(Return(lengths[0]))
+        .WillOnce(Return(lengths[1]))
+        .WillOnce(Return(lengths[2]))
+        .WillOnce(Return(lengths[3]));
+
+    aggregate_result agg({ 0 }, {
+        aggregate_column { aggregate_function::Count, 1 },
+        aggregate_column { aggregate_function::Sum,   2 },
+        aggregate_column { aggregate_function::Min,   3 },
+        aggregate_column { aggregate_function::Max,   4 },
+        aggregate_column { aggregate_function::Avg,   2, 1 },
+    });
+
+    result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
+    for (auto& r : rows)
+        agg.merge(row(result, const_cast<MYSQL_ROW>(r)));
+
+    ASSERT_EQ(3u, agg.size());
+    const aggregate_result::group* de = nullptr;
+    const aggregate_result::group* null = nullptr;
+    for (auto& g : agg.groups())
+    {
+        if (g.second.nulls.at(0))
+            null = &g.second;
+        else if (g.second.keys.at(0) == "de")
+            de = &g.second;
+    }
+    ASSERT_TRUE(de);
+    ASSERT_TRUE(null);
+    EXPECT_EQ(5,  de->values.at(0).result());
+    EXPECT_EQ(30, de->values.at(1).result());
+    EXPECT_EQ(1,  de->values.at(2).result());
+    EXPECT_EQ(9,  de->values.at(3).result());
+    EXPECT_EQ(6,  de->values.at(4).result());
+    EXPECT_EQ(1,  null->values.at(0).result());
+}
+
+TEST(MariaDbTests, AggregateResult_merge_exact)
+{
+    static const char* rows[][5] =
+    {
+        { "9007199254740993", "0.1", "2024-01-01", "2023-12-31 23:59:59", "-01:00:00" },
+        { "9007199254740993", "0.2", "2023-12-31", "2024-01-01 00:00:00", "100:00:00" },
+        { "2",                "0.3", "2024-02-29", "2023-02-01 00:00:00", "00:00:00"  },
+    };
+    static unsigned long lengths[][5] =
+    {
+        { 16, 3, 10, 19, 9 },
+        { 16, 3, 10, 19, 9 },
+        { 1,  3, 10, 19, 8 },
+    };
+    MYSQL_FIELD fields[5];
+    memset(&fields[0], 0, sizeof(fields));
+    fields[0].type = MYSQL_TYPE_NEWDECIMAL;
+    fields[1].type = MYSQL_TYPE_NEWDECIMAL;
+    fields[2].type = MYSQL_TYPE_DATE;
+    fields[3].type = MYSQL_TYPE_DATETIME;
+    fields[4].type = MYSQL_TYPE_TIME;
+
+    NiceMock<MariaDbMock> mock;
+    EXPECT_CALL(mock, mysql_fetch_fields(_))
+        .WillRepeatedly(Return(fields));
+    EXPECT_CALL(mock, mysql_num_fields(_))
+        .WillRepeatedly(Return(5));
+    EXPECT_CALL(mock, mysql_fetch_lengths(_))
+        .WillOnce(Return(lengths[0]))
+        .WillOnce(Return(lengths[1]))
+        .WillOnce(Return(lengths[2]));
+
+    aggregate_result agg({ }, {
+        aggregate_column { aggregate_function::Sum, 0 },
+        aggregate_column { aggregate_function::Sum, 1 },
+        aggregate_column { aggregate_function::Min, 2 },
+        aggregate_column { aggregate_function::Max, 2 },
+        aggregate_column { aggregate_function::Max, 3 },
+        aggregate_column { aggregate_function::Min, 4 },
+        aggregate_column { aggregate_function::Max, 4 },
+    });
+
+    result_stored result(reinterpret_cast<MYSQL_RES*>(0x51651));
+    for (auto& r : rows)
+        agg.merge(row(result, const_cast<MYSQL_ROW>(r)));
+
+    ASSERT_EQ(1u, agg.size());
+    auto& values = agg.groups().begin()->second.values;
+    EXPECT_TRUE(values.at(0).is_exact);
+    EXPECT_EQ(std::string("18014398509481988"),   values.at(0).exact.to_string());
+    EXPECT_EQ(std::string("0.6"),                 values.at(1).exact.to_string());
+    EXPECT_EQ(std::string("2023-12-31"),          values.at(2).text);
+    EXPECT_EQ(std::string("2024-02-29"),          values.at(3).text);
+    EXPECT_EQ(std::string("2024-01-01 00:00:00"), values.at(4).text);
+    EXPECT_EQ(std::string("-01:00:00"),           values.at(5).text);
+    EXPECT_EQ(std::string("100:00:00"),           values.at(6).text);
+}
@@ -74,4 +74,40 @@ MYSQL* STDCALL mysql_real_connect (MYSQL *mysql, const char *host, const char *u
     { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_real_connect(mysql, host, user, passwd, db, port, unix_socket, clientflag) : nullptr); }
 
 MYSQL* STDCALL mysql_init (MYSQL *mysql)
-    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_init(mysql) : nullptr); }
\ No newline at end of file
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_init(mysql) : nullptr); }
+
+unsigned long STDCALL mysql_thread_id (MYSQL *mysql)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_thread_id(mysql) : 0); }
+
+int STDCALL mysql_session_track_get_first (MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_session_track_get_first(mysql, type, data, length) : 0); }
+
+int STDCALL mysql_session_track_get_next (MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_session_track_get_next(mysql, type, data, length) : 0); }
+
+int STDCALL mysql_reset_connection (MYSQL *mysql)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_reset_connection(mysql) : 0); }
+
+my_bool STDCALL mysql_change_user (MYSQL *mysql, const char *user, const char *passwd, const char *db)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_change_user(mysql, user, passwd, db) : 0); }
+
+int STDCALL mysql_ping (MYSQL *mysql)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_ping(mysql) : 0); }
+
+int STDCALL mysql_server_init (int argc, char **argv, char **groups)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_server_init(argc, argv, groups) : 0); }
+
+void STDCALL mysql_server_end (void)
+    { if (mariadb_mock_instance) mariadb_mock_instance->mysql_server_end(); }
+
+my_bool STDCALL mysql_thread_init (void)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_thread_init() : 0); }
+
+void STDCALL mysql_thread_end (void)
+    { if (mariadb_mock_instance) mariadb_mock_instance->mysql_thread_end(); }
+
+int STDCALL mysql_next_result (MYSQL* mysql)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_next_result(mysql) : 0); }
+
+int STDCALL mysql_options (MYSQL *mysql, enum mysql_option option, const void *arg)
+    { return (mariadb_mock_instance ? mariadb_mock_instance->mysql_options(mysql, option, arg) : 0); }
\ No newline at end of file
@@ -89,9 +89,29 @@ public:
     MOCK_METHOD1(mysql_close,              void            (MYSQL *mysql));
     MOCK_METHOD8(mysql_real_connect,       MYSQL*          (MYSQL *mysql, const char *host, const char *user, const char *passwd, const char *db, unsigned int port, const char *unix_socket, unsigned long clientflag));
     MOCK_METHOD1(mysql_init,               MYSQL*          (MYSQL *mysql));
+    MOCK_METHOD1(mysql_thread_id,          unsigned long   (MYSQL *mysql));
+    MOCK_METHOD4(mysql_session_track_get_first, int             (MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length));
+    MOCK_METHOD4(mysql_session_track_get_next, int             (MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length));
+    MOCK_METHOD1(mysql_reset_connection,   int             (MYSQL *mysql));
+    MOCK_METHOD4(mysql_change_user,        my_bool         (MYSQL *mysql, const char *user, const char *passwd, const char *db));
+    MOCK_METHOD1(mysql_ping,               int             (MYSQL *mysql));
+    MOCK_METHOD3(mysql_server_init,        int             (int argc, char **argv, char **groups));
+    MOCK_METHOD0(mysql_server_end,         void            (void));
+    MOCK_METHOD0(mysql_thread_init,        my_bool         (void));
+    MOCK_METHOD0(mysql_thread_end,         void            (void));
+    MOCK_METHOD1(mysql_next_result,        int             (MYSQL* mysql));
+    MOCK_METHOD3(mysql_options,            int             (MYSQL *mysql, enum mysql_option option, const void *arg));
 
     MariaDbMock()
-        { setInstance(this); }
+    {
+        setInstance(this);
+
+        /* the library initializes each thread implicitly on its first use */
+        EXPECT_CALL(*this, mysql_server_init(::testing::_, ::testing::_, ::testing::_)).Times(::testing::AnyNumber());
+        EXPECT_CALL(*this, mysql_server_end()).Times(::testing::AnyNumber());
+        EXPECT_CALL(*this, mysql_thread_init()).Times(::testing::AnyNumber());
+        EXPECT_CALL(*this, mysql_thread_end()).Times(::testing::AnyNumber());
+    }
 
     ~MariaDbMock()
         { clearInstance(this); }
@@ -118,4 +138,16 @@ my_ulonglong        STDCALL mysql_insert_id         (MYSQL *mysql);
 unsigned long       STDCALL mysql_real_escape_string(MYSQL *mysql, char *to,const char *from, unsigned long length);
 void                STDCALL mysql_close             (MYSQL *mysql);
 MYSQL*              STDCALL mysql_real_connect      (MYSQL *mysql, const char *host, const char *user, const char *passwd, const char *db, unsigned int port, const char *unix_socket, unsigned long clientflag);
-MYSQL*              STDCALL mysql_init              (MYSQL *mysql);
\ No newline at end of file
+MYSQL*              STDCALL mysql_init              (MYSQL *mysql);
+unsigned long       STDCALL mysql_thread_id         (MYSQL *mysql);
+int                 STDCALL mysql_session_track_get_first(MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length);
+int                 STDCALL mysql_session_track_get_next(MYSQL *mysql, enum enum_session_state_type type, const char **data, size_t *length);
+int                 STDCALL mysql_reset_connection  (MYSQL *mysql);
+my_bool             STDCALL mysql_change_user       (MYSQL *mysql, const char *user, const char *passwd, const char *db);
+int                 STDCALL mysql_ping              (MYSQL *mysql);
+int                 STDCALL mysql_server_init       (int argc, char **argv, char **groups);
+void                STDCALL mysql_server_end        (void);
+my_bool             STDCALL mysql_thread_init       (void);
+void                STDCALL mysql_thread_end        (void);
+int                 STDCALL mysql_next_result       (MYSQL* mysql);
+int                 STDCALL mysql_options           (MYSQL *mysql, enum mysql_option option, const void *arg);
\ No newline at end of file